@@ -0,0 +1,99 @@
+// Aleatorio.hpp
+
+#pragma once
+
+#include <cstdint> // Para std::uint64_t
+#include <limits>  // Para os limites do gerador
+#include <cstddef> // Para std::size_t
+#include <utility> // Para std::swap
+
+// Passo do SplitMix64: espalha bem os bits de uma semente, usado para semear o gerador principal
+inline std::uint64_t splitmix64(std::uint64_t &estado) noexcept
+{
+    std::uint64_t z = (estado += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Gerador de números aleatórios xoshiro256**: rápido, 32 bytes de estado e sem alocação.
+// Pode ser usado com std::shuffle e as distribuições da <random>.
+class GeradorRapido
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit GeradorRapido(std::uint64_t semente = 0) noexcept
+    {
+        semear(semente);
+    }
+
+    // Semente derivada de uma semente mestre e de um índice (por exemplo, o número do quebra-cabeça),
+    // para que cada item seja reproduzível independentemente de qual thread o gera
+    GeradorRapido(std::uint64_t semente_mestre, std::uint64_t indice) noexcept
+    {
+        semear(semente_mestre, indice);
+    }
+
+    void semear(std::uint64_t semente) noexcept
+    {
+        for (auto &palavra : estado)
+            palavra = splitmix64(semente);
+    }
+
+    void semear(std::uint64_t semente_mestre, std::uint64_t indice) noexcept
+    {
+        std::uint64_t mistura = semente_mestre;
+        mistura = splitmix64(mistura) ^ (indice * 0xD1B54A32D192ED03ull);
+        semear(mistura);
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept
+    {
+        const std::uint64_t resultado = rotacionar(estado[1] * 5, 7) * 9;
+        const std::uint64_t t = estado[1] << 17;
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotacionar(estado[3], 45);
+        return resultado;
+    }
+
+    // Número em [0, limite) sem divisão (método de Lemire, sem rejeição: o viés é desprezível para limites pequenos)
+    std::uint32_t abaixo_de(std::uint32_t limite) noexcept
+    {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * limite >> 32);
+    }
+
+private:
+    std::uint64_t estado[4];
+
+    static std::uint64_t rotacionar(std::uint64_t x, int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+// Embaralha os n primeiros elementos (Fisher-Yates). Ao contrário de std::shuffle, a sequência
+// gerada é a mesma em qualquer biblioteca padrão, então uma semente reproduz o mesmo resultado.
+template <class T>
+void embaralhar(T *inicio, std::size_t n, GeradorRapido &gerador) noexcept
+{
+    for (std::size_t i = n; i > 1; --i)
+    {
+        std::size_t j = gerador.abaixo_de(static_cast<std::uint32_t>(i));
+        std::swap(inicio[i - 1], inicio[j]);
+    }
+}
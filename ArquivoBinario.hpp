@@ -0,0 +1,446 @@
+// ArquivoBinario.hpp
+
+#pragma once
+
+#include <array>       // Para os bytes de um registro
+#include <cstdint>     // Para os campos de tamanho fixo do formato
+#include <cstring>     // Para comparar a assinatura
+#include <fstream>     // Para gravar o arquivo
+#include <string>      // Para nomes de arquivos
+#include <string_view> // Para ler linhas de texto sem cópia
+#include <vector>      // Para o índice
+
+#include "Tabuleiro.hpp"  // Tabuleiro plano de 81 células com máscaras
+#include "Carregador.hpp" // Arquivo mapeado na memória, para ler sem cópia
+
+// Formato binário compacto para coleções grandes de quebra-cabeças ou de soluções.
+//
+// Cabeçalho (32 bytes, little-endian):
+//   0  "SDKA"                  assinatura
+//   4  u16 versão              (1)
+//   6  u16 tipo                (0 = quebra-cabeças, 1 = soluções completas)
+//   8  u64 quantidade          de registros
+//   16 u32 registros por grupo (o índice guarda onde começa cada grupo)
+//   20 u32 reservado           (0)
+//   24 u64 posição do índice   no arquivo
+// Depois vêm os registros e, no final, o índice: um u64 por grupo com a posição do seu primeiro registro.
+// Cada grupo pode ser lido sozinho, então o índice serve para acesso aleatório e para dividir o
+// arquivo entre threads.
+//
+// Registro de quebra-cabeça: 81 bits (11 bytes) dizendo quais células têm pista, seguidos dos dígitos
+// das pistas em 4 bits cada (dois por byte, o primeiro na metade baixa). Um quebra-cabeça de 25 pistas
+// ocupa 24 bytes, contra 82 na linha de texto.
+//
+// Registro de solução: cada uma das 8 primeiras linhas é uma permutação de 1..9, guardada pela sua
+// posição na ordem lexicográfica (0..9!-1, 19 bits); a nona linha sai das colunas. São 152 bits = 19 bytes.
+
+enum class TipoArquivo : std::uint16_t
+{
+    QuebraCabecas = 0,
+    Solucoes = 1,
+};
+
+namespace arquivo_binario
+{
+    constexpr char ASSINATURA[4] = {'S', 'D', 'K', 'A'};
+    constexpr std::uint16_t VERSAO = 1;
+    constexpr std::size_t TAMANHO_CABECALHO = 32;
+    constexpr std::uint32_t REGISTROS_POR_GRUPO = 64;
+    constexpr std::size_t BYTES_MAPA = 11;     // 81 bits de pistas
+    constexpr std::size_t BYTES_SOLUCAO = 19;  // 8 linhas x 19 bits
+    constexpr std::size_t BITS_POSTO = 19;     // 9! = 362880 < 2^19
+
+    // Fatoriais de 0 a 8, para a posição de uma permutação
+    constexpr std::uint32_t FATORIAL[9] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320};
+
+    // Grava um inteiro em little-endian, qualquer que seja a máquina
+    template <class Inteiro>
+    void escrever_le(unsigned char *destino, Inteiro valor) noexcept
+    {
+        for (std::size_t i = 0; i < sizeof(Inteiro); ++i)
+            destino[i] = static_cast<unsigned char>(static_cast<std::uint64_t>(valor) >> (8 * i));
+    }
+
+    template <class Inteiro>
+    Inteiro ler_le(const unsigned char *origem) noexcept
+    {
+        std::uint64_t valor = 0;
+        for (std::size_t i = 0; i < sizeof(Inteiro); ++i)
+            valor |= static_cast<std::uint64_t>(origem[i]) << (8 * i);
+        return static_cast<Inteiro>(valor);
+    }
+
+    // Posição lexicográfica da linha (dígitos 0..8, todos diferentes): código de Lehmer
+    inline std::uint32_t posto_da_linha(const std::uint8_t (&linha)[9]) noexcept
+    {
+        std::uint32_t posto = 0;
+        Mascara usados = 0;
+        for (std::size_t p = 0; p < 8; ++p)
+        {
+            // Quantos dígitos ainda livres são menores que o desta posição
+            Mascara menores_livres = static_cast<Mascara>(((1u << linha[p]) - 1) & ~usados);
+            posto += static_cast<std::uint32_t>(__builtin_popcount(menores_livres)) * FATORIAL[8 - p];
+            usados |= static_cast<Mascara>(1u << linha[p]);
+        }
+        return posto;
+    }
+
+    // Linha (dígitos 0..8) a partir da posição lexicográfica
+    inline void linha_do_posto(std::uint32_t posto, std::uint8_t (&linha)[9]) noexcept
+    {
+        Mascara livres = TODOS_DIGITOS;
+        for (std::size_t p = 0; p < 9; ++p)
+        {
+            std::uint32_t k = posto / FATORIAL[8 - p];
+            posto %= FATORIAL[8 - p];
+            // Escolhe o k-ésimo dígito livre
+            Mascara m = livres;
+            for (std::uint32_t i = 0; i < k; ++i)
+                m &= static_cast<Mascara>(m - 1);
+            linha[p] = static_cast<std::uint8_t>(__builtin_ctz(m));
+            livres &= static_cast<Mascara>(~(1u << linha[p]));
+        }
+    }
+
+    // Codifica um quebra-cabeça; retorna o número de bytes ou 0 se houver caractere que não seja '.' ou '1'..'9'
+    inline std::size_t codificar_quebra_cabeca(const Tabuleiro &tabuleiro, unsigned char (&destino)[BYTES_MAPA + 41]) noexcept
+    {
+        std::memset(destino, 0, sizeof(destino));
+        std::size_t pistas = 0;
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            char c = tabuleiro.celulas[celula];
+            if (c == '.')
+                continue;
+            if (c < '1' || c > '9')
+                return 0;
+            destino[celula / 8] |= static_cast<unsigned char>(1u << (celula % 8));
+            destino[BYTES_MAPA + pistas / 2] |= static_cast<unsigned char>((c - '0') << (4 * (pistas % 2)));
+            ++pistas;
+        }
+        return BYTES_MAPA + (pistas + 1) / 2;
+    }
+
+    // Decodifica um quebra-cabeça a partir de 'origem' sem passar de 'limite'; retorna o fim do registro
+    // ou nullptr se o registro estiver truncado ou corrompido
+    inline const unsigned char *decodificar_quebra_cabeca(const unsigned char *origem, const unsigned char *limite,
+                                                           Tabuleiro &tabuleiro) noexcept
+    {
+        if (limite - origem < static_cast<std::ptrdiff_t>(BYTES_MAPA))
+            return nullptr;
+        std::size_t pistas = 0;
+        for (std::size_t i = 0; i < BYTES_MAPA; ++i)
+            pistas += static_cast<std::size_t>(__builtin_popcount(origem[i]));
+        if (pistas > 81 || limite - origem < static_cast<std::ptrdiff_t>(BYTES_MAPA + (pistas + 1) / 2))
+            return nullptr;
+
+        const unsigned char *digitos = origem + BYTES_MAPA;
+        std::size_t lidas = 0;
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            if (!(origem[celula / 8] & (1u << (celula % 8))))
+            {
+                tabuleiro.celulas[celula] = '.';
+                continue;
+            }
+            unsigned valor = (digitos[lidas / 2] >> (4 * (lidas % 2))) & 0xF;
+            if (valor < 1 || valor > 9)
+                return nullptr;
+            tabuleiro.celulas[celula] = static_cast<char>('0' + valor);
+            ++lidas;
+        }
+        return digitos + (pistas + 1) / 2;
+    }
+
+    // Codifica uma solução completa; retorna false se alguma das 8 primeiras linhas não for uma permutação de 1..9
+    inline bool codificar_solucao(const Tabuleiro &tabuleiro, unsigned char (&destino)[BYTES_SOLUCAO]) noexcept
+    {
+        std::memset(destino, 0, sizeof(destino));
+        std::size_t bit = 0;
+        for (std::size_t l = 0; l < 8; ++l)
+        {
+            std::uint8_t linha[9];
+            Mascara vistos = 0;
+            for (std::size_t c = 0; c < 9; ++c)
+            {
+                char d = tabuleiro(l, c);
+                if (d < '1' || d > '9')
+                    return false;
+                linha[c] = static_cast<std::uint8_t>(d - '1');
+                vistos |= static_cast<Mascara>(1u << linha[c]);
+            }
+            if (vistos != TODOS_DIGITOS)
+                return false;
+            std::uint32_t posto = posto_da_linha(linha);
+            for (std::size_t b = 0; b < BITS_POSTO; ++b, ++bit)
+                if (posto & (1u << b))
+                    destino[bit / 8] |= static_cast<unsigned char>(1u << (bit % 8));
+        }
+        return true;
+    }
+
+    // Decodifica uma solução; a nona linha recebe, em cada coluna, o dígito que falta nela
+    inline const unsigned char *decodificar_solucao(const unsigned char *origem, const unsigned char *limite,
+                                                     Tabuleiro &tabuleiro) noexcept
+    {
+        if (limite - origem < static_cast<std::ptrdiff_t>(BYTES_SOLUCAO))
+            return nullptr;
+        Mascara colunas[9] = {};
+        std::size_t bit = 0;
+        for (std::size_t l = 0; l < 8; ++l)
+        {
+            std::uint32_t posto = 0;
+            for (std::size_t b = 0; b < BITS_POSTO; ++b, ++bit)
+                if (origem[bit / 8] & (1u << (bit % 8)))
+                    posto |= 1u << b;
+            if (posto >= 362880)
+                return nullptr;
+            std::uint8_t linha[9];
+            linha_do_posto(posto, linha);
+            for (std::size_t c = 0; c < 9; ++c)
+            {
+                tabuleiro(l, c) = static_cast<char>('1' + linha[c]);
+                colunas[c] |= static_cast<Mascara>(1u << linha[c]);
+            }
+        }
+        for (std::size_t c = 0; c < 9; ++c)
+        {
+            Mascara falta = static_cast<Mascara>(~colunas[c] & TODOS_DIGITOS);
+            tabuleiro(8, c) = falta ? static_cast<char>('1' + __builtin_ctz(falta)) : '.';
+        }
+        return origem + BYTES_SOLUCAO;
+    }
+}
+
+// Grava um arquivo binário registro a registro; o índice e a quantidade vão para o arquivo em fechar()
+class EscritorArquivo
+{
+public:
+    ~EscritorArquivo()
+    {
+        fechar();
+    }
+
+    bool abrir(const std::string &nome_arquivo, TipoArquivo tipo_arquivo)
+    {
+        arquivo.open(nome_arquivo, std::ios::binary | std::ios::trunc);
+        if (!arquivo.is_open())
+            return false;
+        tipo = tipo_arquivo;
+        quantidade = 0;
+        posicao = arquivo_binario::TAMANHO_CABECALHO;
+        indice.clear();
+        // Cabeçalho provisório; o definitivo é gravado no fechar
+        unsigned char cabecalho[arquivo_binario::TAMANHO_CABECALHO] = {};
+        arquivo.write(reinterpret_cast<const char *>(cabecalho), sizeof(cabecalho));
+        return static_cast<bool>(arquivo);
+    }
+
+    // Acrescenta um tabuleiro; retorna false se ele não couber no tipo do arquivo
+    // (caractere inválido num quebra-cabeça, ou linha que não é permutação numa solução)
+    bool escrever(const Tabuleiro &tabuleiro)
+    {
+        unsigned char bytes[arquivo_binario::BYTES_MAPA + 41];
+        std::size_t tamanho;
+        if (tipo == TipoArquivo::Solucoes)
+        {
+            unsigned char solucao[arquivo_binario::BYTES_SOLUCAO];
+            if (!arquivo_binario::codificar_solucao(tabuleiro, solucao))
+                return false;
+            std::memcpy(bytes, solucao, sizeof(solucao));
+            tamanho = sizeof(solucao);
+        }
+        else if ((tamanho = arquivo_binario::codificar_quebra_cabeca(tabuleiro, bytes)) == 0)
+        {
+            return false;
+        }
+
+        if (quantidade % arquivo_binario::REGISTROS_POR_GRUPO == 0)
+            indice.push_back(posicao);
+        arquivo.write(reinterpret_cast<const char *>(bytes), static_cast<std::streamsize>(tamanho));
+        posicao += tamanho;
+        ++quantidade;
+        return true;
+    }
+
+    // Acrescenta cada linha de 81 caracteres do texto; retorna quantas não puderam ser gravadas
+    std::size_t escrever_texto(std::string_view texto)
+    {
+        std::size_t rejeitadas = 0;
+        Tabuleiro tabuleiro;
+        while (!texto.empty())
+        {
+            std::size_t quebra = texto.find('\n');
+            std::string_view linha = texto.substr(0, quebra);
+            texto.remove_prefix(quebra == std::string_view::npos ? texto.size() : quebra + 1);
+            if (!linha.empty() && linha.back() == '\r')
+                linha.remove_suffix(1);
+            if (linha.empty() || linha[0] == '#')
+                continue;
+            if (!linha_para_tabuleiro(linha, tabuleiro) || !escrever(tabuleiro))
+                ++rejeitadas;
+        }
+        return rejeitadas;
+    }
+
+    // Grava o índice e o cabeçalho definitivo; retorna false se alguma escrita falhou
+    bool fechar()
+    {
+        if (!arquivo.is_open())
+            return true;
+        std::vector<unsigned char> bytes_indice(indice.size() * 8);
+        for (std::size_t g = 0; g < indice.size(); ++g)
+            arquivo_binario::escrever_le(&bytes_indice[g * 8], indice[g]);
+        arquivo.write(reinterpret_cast<const char *>(bytes_indice.data()), static_cast<std::streamsize>(bytes_indice.size()));
+
+        unsigned char cabecalho[arquivo_binario::TAMANHO_CABECALHO] = {};
+        std::memcpy(cabecalho, arquivo_binario::ASSINATURA, 4);
+        arquivo_binario::escrever_le(cabecalho + 4, arquivo_binario::VERSAO);
+        arquivo_binario::escrever_le(cabecalho + 6, static_cast<std::uint16_t>(tipo));
+        arquivo_binario::escrever_le(cabecalho + 8, quantidade);
+        arquivo_binario::escrever_le(cabecalho + 16, arquivo_binario::REGISTROS_POR_GRUPO);
+        arquivo_binario::escrever_le(cabecalho + 24, posicao);
+        arquivo.seekp(0);
+        arquivo.write(reinterpret_cast<const char *>(cabecalho), sizeof(cabecalho));
+        bool ok = static_cast<bool>(arquivo);
+        arquivo.close();
+        return ok;
+    }
+
+    std::uint64_t registros() const noexcept
+    {
+        return quantidade;
+    }
+
+private:
+    std::ofstream arquivo;
+    TipoArquivo tipo = TipoArquivo::QuebraCabecas;
+    std::uint64_t quantidade = 0;
+    std::uint64_t posicao = 0;
+    std::vector<std::uint64_t> indice;
+};
+
+// Lê um arquivo binário mapeado na memória. O leitor só guarda o mapeamento e o cabeçalho;
+// cada thread usa o seu Cursor para decodificar os registros.
+class LeitorArquivo
+{
+public:
+    // Diz se o arquivo começa com a assinatura do formato (sem abri-lo como binário)
+    static bool e_binario(const std::string &nome_arquivo)
+    {
+        std::ifstream arquivo(nome_arquivo, std::ios::binary);
+        char assinatura[4];
+        return arquivo.read(assinatura, 4) && std::memcmp(assinatura, arquivo_binario::ASSINATURA, 4) == 0;
+    }
+
+    // Mapeia o arquivo e confere o cabeçalho e o índice; retorna false se não for um arquivo válido
+    bool abrir(const std::string &nome_arquivo)
+    {
+        if (!mapa.abrir(nome_arquivo))
+            return false;
+        std::string_view conteudo = mapa.conteudo();
+        inicio = reinterpret_cast<const unsigned char *>(conteudo.data());
+        const std::uint64_t tamanho = conteudo.size();
+        if (tamanho < arquivo_binario::TAMANHO_CABECALHO || std::memcmp(inicio, arquivo_binario::ASSINATURA, 4) != 0 ||
+            arquivo_binario::ler_le<std::uint16_t>(inicio + 4) != arquivo_binario::VERSAO)
+            return false;
+
+        std::uint16_t tipo_lido = arquivo_binario::ler_le<std::uint16_t>(inicio + 6);
+        if (tipo_lido > static_cast<std::uint16_t>(TipoArquivo::Solucoes))
+            return false;
+        tipo_arquivo = static_cast<TipoArquivo>(tipo_lido);
+        num_registros = arquivo_binario::ler_le<std::uint64_t>(inicio + 8);
+        por_grupo = arquivo_binario::ler_le<std::uint32_t>(inicio + 16);
+        posicao_indice = arquivo_binario::ler_le<std::uint64_t>(inicio + 24);
+        if (por_grupo == 0 || posicao_indice < arquivo_binario::TAMANHO_CABECALHO || posicao_indice > tamanho)
+            return false;
+        // Cada registro ocupa pelo menos o mapa de pistas (ou a solução inteira): uma quantidade maior do que
+        // cabe entre o cabeçalho e o índice vem de um cabeçalho corrompido, e evita o estouro na conta dos grupos
+        std::uint64_t menor_registro = tipo_arquivo == TipoArquivo::Solucoes ? arquivo_binario::BYTES_SOLUCAO
+                                                                             : arquivo_binario::BYTES_MAPA;
+        if (num_registros > (posicao_indice - arquivo_binario::TAMANHO_CABECALHO) / menor_registro)
+            return false;
+        num_grupos = num_registros / por_grupo + (num_registros % por_grupo != 0);
+        if ((tamanho - posicao_indice) / 8 < num_grupos)
+            return false;
+        return true;
+    }
+
+    TipoArquivo tipo() const noexcept
+    {
+        return tipo_arquivo;
+    }
+
+    std::uint64_t quantidade() const noexcept
+    {
+        return num_registros;
+    }
+
+    std::uint64_t grupos() const noexcept
+    {
+        return num_grupos;
+    }
+
+    std::uint32_t registros_por_grupo() const noexcept
+    {
+        return por_grupo;
+    }
+
+    // Decodifica registros em sequência; posicionar num registro custa no máximo um grupo de leitura
+    class Cursor
+    {
+    public:
+        explicit Cursor(const LeitorArquivo &leitor_usado) noexcept : leitor(&leitor_usado) {}
+
+        // Lê o registro de número 'indice'; retorna false se ele não existir ou estiver corrompido
+        bool ler(std::uint64_t indice, Tabuleiro &tabuleiro) noexcept
+        {
+            if (indice >= leitor->num_registros)
+                return false;
+            // Fora da sequência: volta para o começo do grupo do registro
+            if (!atual || indice != proximo)
+            {
+                std::uint64_t grupo = indice / leitor->por_grupo;
+                std::uint64_t deslocamento = leitor->inicio_do_grupo(grupo);
+                if (deslocamento < arquivo_binario::TAMANHO_CABECALHO || deslocamento > leitor->posicao_indice)
+                    return false;
+                atual = leitor->inicio + deslocamento;
+                proximo = grupo * leitor->por_grupo;
+            }
+            while (atual)
+            {
+                atual = leitor->decodificar(atual, tabuleiro);
+                if (proximo++ == indice)
+                    break;
+            }
+            return atual != nullptr;
+        }
+
+    private:
+        const LeitorArquivo *leitor;
+        const unsigned char *atual = nullptr;
+        std::uint64_t proximo = 0;
+    };
+
+private:
+    ArquivoMapeado mapa;
+    const unsigned char *inicio = nullptr;
+    TipoArquivo tipo_arquivo = TipoArquivo::QuebraCabecas;
+    std::uint64_t num_registros = 0;
+    std::uint64_t num_grupos = 0;
+    std::uint32_t por_grupo = 0;
+    std::uint64_t posicao_indice = 0;
+
+    std::uint64_t inicio_do_grupo(std::uint64_t grupo) const noexcept
+    {
+        return arquivo_binario::ler_le<std::uint64_t>(inicio + posicao_indice + grupo * 8);
+    }
+
+    const unsigned char *decodificar(const unsigned char *origem, Tabuleiro &tabuleiro) const noexcept
+    {
+        const unsigned char *limite = inicio + posicao_indice;
+        if (tipo_arquivo == TipoArquivo::Solucoes)
+            return arquivo_binario::decodificar_solucao(origem, limite, tabuleiro);
+        return arquivo_binario::decodificar_quebra_cabeca(origem, limite, tabuleiro);
+    }
+};
@@ -0,0 +1,112 @@
+// BuscaParalela.hpp
+
+#pragma once
+
+#include <algorithm> // Para std::min, std::max e std::find
+#include <atomic>    // Para o cancelamento e a soma das contagens entre as threads
+#include <cstddef>   // Para std::size_t
+#include <limits>    // Para marcar que nenhuma subárvore achou solução
+#include <string>    // Para o motivo da validação
+#include <vector>    // Para as subárvores e os solucionadores de cada thread
+
+#include "Tabuleiro.hpp"        // Tabuleiro plano com as máscaras de linha, coluna e região
+#include "Solucao.hpp"          // Propagação + backtracking de cada subárvore
+#include "ExecutorParalelo.hpp" // Grupo de threads fixas com roubo de trabalho
+
+// Resolve UM quebra-cabeça com várias threads. A árvore de busca é dividida nos primeiros níveis em
+// subárvores independentes (Solucao::dividir), cada uma numa cópia do tabuleiro com as suas máscaras,
+// e as subárvores são distribuídas com roubo de trabalho entre as threads de um GrupoThreads, criadas
+// uma vez no construtor (cada tabuleiro só acorda as threads, sem criá-las de novo). Na resolução, a primeira
+// solução encontrada cancela as outras buscas; na contagem, as contagens das subárvores são somadas e
+// o limite alcançado cancela o resto. Serve para os tabuleiros difíceis ou sem solução, em que uma
+// busca só, num núcleo, define a latência. Com mais de uma solução, qualquer uma pode ser a devolvida.
+class SolucaoParalela
+{
+public:
+    // Subárvores por thread: sobra trabalho para roubar quando uma subárvore é bem maior que as outras
+    static constexpr std::size_t TAREFAS_POR_THREAD = 8;
+
+    explicit SolucaoParalela(unsigned threads = threads_disponiveis())
+        : num_threads(std::max(1u, threads)), solucionadores(num_threads), grupo(num_threads)
+    {
+    }
+
+    // Mesma interface de Solucao::resolverSudoku
+    bool resolverSudoku(Tabuleiro &tabuleiro)
+    {
+        if (num_threads == 1)
+            return solucionadores[0].resolverSudoku(tabuleiro);
+
+        // Tabuleiros fáceis terminam já na divisão, sem criar nenhuma thread
+        solucionadores[0].dividir(tabuleiro, TAREFAS_POR_THREAD * num_threads, tarefas);
+        for (const Tabuleiro &tarefa : tarefas)
+        {
+            if (std::find(tarefa.celulas.begin(), tarefa.celulas.end(), '.') == tarefa.celulas.end())
+            {
+                tabuleiro = tarefa;
+                return true;
+            }
+        }
+        if (tarefas.empty())
+            return false;
+
+        constexpr std::size_t NENHUMA = std::numeric_limits<std::size_t>::max();
+        std::atomic<bool> achou{false};
+        std::atomic<std::size_t> vencedora{NENHUMA};
+        for (Solucao<> &solucionador : solucionadores)
+            solucionador.cancelar_com(&achou);
+        grupo.executar(tarefas.size(), [&](std::size_t tarefa, unsigned id)
+                       {
+            if (achou.load(std::memory_order_relaxed))
+                return;
+            // Cada subárvore é resolvida na própria cópia; a primeira que resolver fica com a vitória
+            if (solucionadores[id].resolverSudoku(tarefas[tarefa]))
+            {
+                std::size_t esperado = NENHUMA;
+                if (vencedora.compare_exchange_strong(esperado, tarefa))
+                    achou.store(true, std::memory_order_relaxed);
+            } });
+        for (Solucao<> &solucionador : solucionadores)
+            solucionador.cancelar_com(nullptr);
+
+        if (vencedora.load() == NENHUMA)
+            return false;
+        tabuleiro = tarefas[vencedora.load()];
+        return true;
+    }
+
+    // Mesma interface de Solucao::contarSolucoes: soma as soluções das subárvores até o limite
+    std::size_t contarSolucoes(Tabuleiro tabuleiro, std::size_t limite = 2)
+    {
+        if (num_threads == 1)
+            return solucionadores[0].contarSolucoes(tabuleiro, limite);
+
+        solucionadores[0].dividir(tabuleiro, TAREFAS_POR_THREAD * num_threads, tarefas);
+        std::atomic<bool> chegou{false};
+        std::atomic<std::size_t> total{0};
+        for (Solucao<> &solucionador : solucionadores)
+            solucionador.cancelar_com(&chegou);
+        grupo.executar(tarefas.size(), [&](std::size_t tarefa, unsigned id)
+                       {
+            if (chegou.load(std::memory_order_relaxed))
+                return;
+            std::size_t encontradas = solucionadores[id].contarSolucoes(tarefas[tarefa], limite);
+            if (total.fetch_add(encontradas) + encontradas >= limite)
+                chegou.store(true, std::memory_order_relaxed); });
+        for (Solucao<> &solucionador : solucionadores)
+            solucionador.cancelar_com(nullptr);
+        return std::min(total.load(), limite);
+    }
+
+    // Mesma interface de Solucao::validarTabuleiro (sem estatísticas)
+    std::string validarTabuleiro(const Tabuleiro &tabuleiro) const
+    {
+        return validar_tabuleiro(tabuleiro);
+    }
+
+private:
+    unsigned num_threads;
+    std::vector<Solucao<>> solucionadores; // Um por thread
+    std::vector<Tabuleiro> tarefas;       // Reaproveitado entre as chamadas
+    GrupoThreads grupo;                   // Por último: as threads terminam antes dos solucionadores sumirem
+};
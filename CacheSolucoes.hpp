@@ -0,0 +1,291 @@
+// CacheSolucoes.hpp
+
+#pragma once
+
+#include <algorithm>     // Para std::copy e std::equal
+#include <array>         // Para as chaves de 81 caracteres
+#include <chrono>        // Para medir o tempo das consultas
+#include <cstdint>       // Para std::uint64_t
+#include <cstdio>        // Para formatar os tempos (snprintf)
+#include <fstream>       // Para acrescentar as soluções novas no índice em disco
+#include <functional>    // Para std::hash
+#include <list>          // Para a ordem de uso do LRU
+#include <mutex>         // Para proteger o cache compartilhado entre as threads
+#include <string>        // Para o caminho do índice e o JSON
+#include <string_view>   // Para as entradas do índice, que apontam direto para o arquivo mapeado
+#include <unordered_map> // Para achar as chaves em O(1)
+#include <utility>       // Para mover o resolvedor base
+
+#include "Tabuleiro.hpp"  // Tabuleiro plano de 81 células com máscaras
+#include "Solucao.hpp"    // Conferência das soluções lidas do índice
+#include "Simetria.hpp"   // Forma canônica pelas simetrias do Sudoku
+#include "Carregador.hpp" // Leitura do índice mapeado na memória
+
+// Cache de soluções indexado pela forma canônica: quebra-cabeças iguais a menos de simetrias (troca de
+// bandas, pilhas, linhas, colunas, transposição e troca de dígitos) usam a mesma solução, guardada já na
+// forma canônica e transformada de volta para cada quebra-cabeça.
+//
+// Níveis:
+//   memória: LRU limitado a 'capacidade' entradas
+//   disco:   índice opcional em texto, uma linha "forma_canônica solução_canônica" por quebra-cabeça;
+//            o arquivo é mapeado na memória e as soluções novas são acrescentadas no final. O arquivo
+//            pode ter sido editado, truncado ou gravado por outra versão, então cada solução lida dele
+//            é conferida antes de ser usada; a errada é resolvida de novo e a correção vai para o final
+//            (com a mesma forma repetida, vale a última linha)
+
+using ChaveCanonica = std::array<char, 81>;
+
+struct HashChaveCanonica
+{
+    std::size_t operator()(const ChaveCanonica &chave) const noexcept
+    {
+        return std::hash<std::string_view>{}(std::string_view(chave.data(), chave.size()));
+    }
+};
+
+// Contadores do cache de cada thread, somados no final como EstatisticasBusca
+struct EstatisticasCache
+{
+    std::uint64_t consultas = 0;
+    std::uint64_t acertos_memoria = 0;
+    std::uint64_t acertos_disco = 0;
+    std::uint64_t sem_forma = 0;        // Tabuleiros com simetrias demais, resolvidos sem o cache
+    double segundos_canonizacao = 0.0;
+    double segundos_consulta = 0.0;     // Canonização + busca no cache + transformação de volta
+
+    std::uint64_t acertos() const noexcept
+    {
+        return acertos_memoria + acertos_disco;
+    }
+
+    void somar(const EstatisticasCache &outra) noexcept
+    {
+        consultas += outra.consultas;
+        acertos_memoria += outra.acertos_memoria;
+        acertos_disco += outra.acertos_disco;
+        sem_forma += outra.sem_forma;
+        segundos_canonizacao += outra.segundos_canonizacao;
+        segundos_consulta += outra.segundos_consulta;
+    }
+
+    // Campos JSON (sem as chaves de abertura e fechamento), com a taxa de acerto e as médias em microssegundos
+    void escrever_campos_json(std::string &saida) const
+    {
+        double por_consulta = consultas ? 1e6 / static_cast<double>(consultas) : 0.0;
+        char texto[192];
+        std::snprintf(texto, sizeof(texto),
+                      "\"taxa_acerto\": %.4f, \"us_canonizacao\": %.3f, \"us_consulta\": %.3f",
+                      consultas ? static_cast<double>(acertos()) / static_cast<double>(consultas) : 0.0,
+                      segundos_canonizacao * por_consulta, segundos_consulta * por_consulta);
+        saida += "\"consultas\": " + std::to_string(consultas) +
+                 ", \"acertos_memoria\": " + std::to_string(acertos_memoria) +
+                 ", \"acertos_disco\": " + std::to_string(acertos_disco) +
+                 ", \"sem_forma\": " + std::to_string(sem_forma) + ", " + texto;
+    }
+};
+
+// Cache compartilhado entre as threads (uma trava só: as consultas são curtas perto da canonização,
+// que cada thread faz fora dela)
+class CacheSolucoes
+{
+public:
+    enum class Origem
+    {
+        Nenhuma,
+        Memoria,
+        Disco
+    };
+
+    explicit CacheSolucoes(std::size_t capacidade_maxima) : capacidade(capacidade_maxima) {}
+
+    // Carrega o índice (se existir) e passa a acrescentar nele as soluções novas; retorna false se não
+    // conseguir abrir o arquivo para escrita. Linhas que não estão no formato são ignoradas; com a mesma
+    // forma em mais de uma linha, vale a última (uma correção acrescentada depois).
+    bool abrir_indice(const std::string &caminho)
+    {
+        if (entrada_indice.abrir(caminho))
+        {
+            for (std::string_view linha : entrada_indice.linhas())
+            {
+                if (linha.size() != 163 || linha[81] != ' ')
+                    continue;
+                Tabuleiro chave, solucao;
+                if (!linha_para_tabuleiro(linha.substr(0, 81), chave) ||
+                    !linha_para_tabuleiro(linha.substr(82), solucao))
+                    continue;
+                indice[chave.celulas] = linha.data() + 82;
+            }
+        }
+        indice_saida.open(caminho, std::ios::binary | std::ios::app);
+        return indice_saida.is_open();
+    }
+
+    // Procura a solução canônica da forma canônica dada, primeiro na memória e depois no índice. O que vem
+    // do índice ainda não foi conferido: só entra na memória quando quem procurou chamar guardar.
+    Origem procurar(const ChaveCanonica &chave, ChaveCanonica &solucao)
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        auto posicao = posicoes.find(chave);
+        if (posicao != posicoes.end())
+        {
+            // Vai para a frente da lista: é o mais recente
+            recentes.splice(recentes.begin(), recentes, posicao->second);
+            solucao = posicao->second->second;
+            return Origem::Memoria;
+        }
+
+        // As acrescentadas nesta execução vêm antes: podem ser a correção de uma linha do arquivo
+        auto acrescentada = acrescentadas.find(chave);
+        if (acrescentada != acrescentadas.end())
+        {
+            solucao = acrescentada->second;
+            return Origem::Disco;
+        }
+        auto no_indice = indice.find(chave);
+        if (no_indice != indice.end())
+        {
+            std::copy(no_indice->second, no_indice->second + 81, solucao.begin());
+            return Origem::Disco;
+        }
+        return Origem::Nenhuma;
+    }
+
+    // Guarda a solução canônica (já conferida) na memória e, se o índice ainda não tiver essa mesma
+    // solução, no final dele
+    void guardar(const ChaveCanonica &chave, const ChaveCanonica &solucao)
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        if (posicoes.count(chave))
+            return;
+        inserir(chave, solucao);
+        auto no_indice = indice.find(chave);
+        bool no_disco = no_indice != indice.end() && std::equal(solucao.begin(), solucao.end(), no_indice->second);
+        if (indice_saida.is_open() && !no_disco && acrescentadas.emplace(chave, solucao).second)
+        {
+            indice_saida.write(chave.data(), 81);
+            indice_saida.put(' ');
+            indice_saida.write(solucao.data(), 81);
+            indice_saida.put('\n');
+        }
+    }
+
+    // Grava no disco o que ainda estiver no buffer do índice
+    void descarregar()
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        if (indice_saida.is_open())
+            indice_saida.flush();
+    }
+
+    std::size_t tamanho_memoria()
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        return recentes.size();
+    }
+
+    std::size_t tamanho_indice()
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        return indice.size() + acrescentadas.size();
+    }
+
+private:
+    using Entrada = std::pair<ChaveCanonica, ChaveCanonica>;
+
+    std::mutex trava;
+    std::size_t capacidade;
+    std::list<Entrada> recentes; // Mais recente na frente
+    std::unordered_map<ChaveCanonica, std::list<Entrada>::iterator, HashChaveCanonica> posicoes;
+
+    EntradaQuebraCabecas entrada_indice;
+    std::unordered_map<ChaveCanonica, const char *, HashChaveCanonica> indice; // Solução direto no arquivo mapeado
+    std::unordered_map<ChaveCanonica, ChaveCanonica, HashChaveCanonica> acrescentadas; // Gravadas nesta execução
+    std::ofstream indice_saida;
+
+    // Coloca na frente do LRU e descarta a menos usada se passar da capacidade (com a trava já tomada)
+    void inserir(const ChaveCanonica &chave, const ChaveCanonica &solucao)
+    {
+        if (capacidade == 0)
+            return;
+        recentes.emplace_front(chave, solucao);
+        posicoes[chave] = recentes.begin();
+        if (recentes.size() > capacidade)
+        {
+            posicoes.erase(recentes.back().first);
+            recentes.pop_back();
+        }
+    }
+};
+
+// Resolvedor com a mesma interface de Solucionador que consulta o cache antes de resolver.
+// Cada thread tem o seu (com o seu Canonizador e os seus contadores); o cache é compartilhado.
+template <class Base>
+class ResolvedorComCache
+{
+public:
+    ResolvedorComCache(Base base_usada, CacheSolucoes &cache_usado) : base(std::move(base_usada)), cache(&cache_usado) {}
+
+    std::string validarTabuleiro(const Tabuleiro &tabuleiro) const
+    {
+        return base.validarTabuleiro(tabuleiro);
+    }
+
+    // Resolve pelo cache quando a forma canônica já foi vista; senão resolve com a base e guarda a solução
+    bool resolverSudoku(Tabuleiro &tabuleiro)
+    {
+        auto inicio = std::chrono::steady_clock::now();
+        Tabuleiro canonico;
+        Transformacao transformacao;
+        bool tem_forma = canonizador.canonizar(tabuleiro, canonico, transformacao);
+        auto canonizado = std::chrono::steady_clock::now();
+        ++contadores.consultas;
+        contadores.segundos_canonizacao += std::chrono::duration<double>(canonizado - inicio).count();
+        if (!tem_forma)
+        {
+            ++contadores.sem_forma;
+            contadores.segundos_consulta += std::chrono::duration<double>(canonizado - inicio).count();
+            return base.resolverSudoku(tabuleiro);
+        }
+
+        transformacao.completar();
+        Tabuleiro solucao;
+        CacheSolucoes::Origem origem = cache->procurar(canonico.celulas, solucao.celulas);
+        if (origem == CacheSolucoes::Origem::Memoria)
+        {
+            tabuleiro = transformacao.desfazer(solucao);
+            ++contadores.acertos_memoria;
+        }
+        else if (origem == CacheSolucoes::Origem::Disco)
+        {
+            // Do índice, só vale a solução que confere com este quebra-cabeça; a errada conta como falta
+            Tabuleiro desfeita = transformacao.desfazer(solucao);
+            if (verificar_solucao(tabuleiro, desfeita).empty())
+            {
+                tabuleiro = desfeita;
+                cache->guardar(canonico.celulas, solucao.celulas);
+                ++contadores.acertos_disco;
+            }
+            else
+                origem = CacheSolucoes::Origem::Nenhuma;
+        }
+        contadores.segundos_consulta += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        if (origem != CacheSolucoes::Origem::Nenhuma)
+            return true;
+
+        if (!base.resolverSudoku(tabuleiro))
+            return false;
+        cache->guardar(canonico.celulas, transformacao.aplicar(tabuleiro).celulas);
+        return true;
+    }
+
+    const EstatisticasCache &estatisticas() const noexcept
+    {
+        return contadores;
+    }
+
+private:
+    Base base;
+    CacheSolucoes *cache;
+    Canonizador canonizador;
+    EstatisticasCache contadores;
+};
@@ -0,0 +1,193 @@
+// Carregador.hpp
+
+#pragma once
+
+#include <string>      // Para o caminho e o buffer da leitura em fluxo
+#include <string_view> // Para as linhas apontando direto para o arquivo, sem cópia
+#include <vector>      // Para a lista de linhas
+#include <iostream>    // Para ler da entrada padrão
+#include <fstream>     // Para ler arquivos que não podem ser mapeados
+#include <cstring>     // Para std::memchr
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // Para CreateFileMapping/MapViewOfFile
+#else
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap/munmap
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para close
+#endif
+
+// Arquivo mapeado na memória só para leitura: o sistema traz as páginas sob demanda,
+// sem copiar o conteúdo para um buffer nosso
+class ArquivoMapeado
+{
+public:
+    ArquivoMapeado() = default;
+    ArquivoMapeado(const ArquivoMapeado &) = delete;
+    ArquivoMapeado &operator=(const ArquivoMapeado &) = delete;
+
+    ~ArquivoMapeado()
+    {
+        fechar();
+    }
+
+    // Mapeia o arquivo inteiro; retorna false se não der (arquivo inexistente, pipe, arquivo vazio...)
+    bool abrir(const std::string &caminho)
+    {
+        fechar();
+#if defined(_WIN32)
+        arquivo = CreateFileA(caminho.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (arquivo == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER tamanho_arquivo;
+        if (GetFileType(arquivo) != FILE_TYPE_DISK || !GetFileSizeEx(arquivo, &tamanho_arquivo) ||
+            tamanho_arquivo.QuadPart == 0)
+        {
+            fechar();
+            return false;
+        }
+        mapeamento = CreateFileMappingA(arquivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapeamento)
+        {
+            fechar();
+            return false;
+        }
+        inicio = static_cast<const char *>(MapViewOfFile(mapeamento, FILE_MAP_READ, 0, 0, 0));
+        if (!inicio)
+        {
+            fechar();
+            return false;
+        }
+        tamanho = static_cast<std::size_t>(tamanho_arquivo.QuadPart);
+        return true;
+#else
+        int descritor = ::open(caminho.c_str(), O_RDONLY);
+        if (descritor < 0)
+            return false;
+        struct stat info;
+        if (::fstat(descritor, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+        {
+            ::close(descritor);
+            return false;
+        }
+        void *endereco = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descritor, 0);
+        ::close(descritor); // O mapeamento continua válido depois de fechar o descritor
+        if (endereco == MAP_FAILED)
+            return false;
+        ::madvise(endereco, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL); // Leitura do começo ao fim
+        inicio = static_cast<const char *>(endereco);
+        tamanho = static_cast<std::size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void fechar() noexcept
+    {
+#if defined(_WIN32)
+        if (inicio)
+            UnmapViewOfFile(inicio);
+        if (mapeamento)
+            CloseHandle(mapeamento);
+        if (arquivo != INVALID_HANDLE_VALUE)
+            CloseHandle(arquivo);
+        mapeamento = nullptr;
+        arquivo = INVALID_HANDLE_VALUE;
+#else
+        if (inicio)
+            ::munmap(const_cast<char *>(inicio), tamanho);
+#endif
+        inicio = nullptr;
+        tamanho = 0;
+    }
+
+    std::string_view conteudo() const noexcept
+    {
+        return std::string_view(inicio, tamanho);
+    }
+
+private:
+    const char *inicio = nullptr;
+    std::size_t tamanho = 0;
+#if defined(_WIN32)
+    HANDLE arquivo = INVALID_HANDLE_VALUE;
+    HANDLE mapeamento = nullptr;
+#endif
+};
+
+// Entrada de quebra-cabeças de um arquivo (mapeado na memória) ou da entrada padrão ("-").
+// As linhas são visões direto no conteúdo, sem cópia; valem enquanto a entrada existir.
+// Linhas vazias ou começando com '#' são ignoradas e o '\r' de arquivos do Windows é removido.
+class EntradaQuebraCabecas
+{
+public:
+    // Abre a entrada; retorna false se o arquivo não puder ser lido
+    bool abrir(const std::string &caminho)
+    {
+        linhas_lidas.clear();
+        mapa.fechar();
+        buffer.clear();
+
+        std::string_view conteudo;
+        if (caminho != "-" && mapa.abrir(caminho))
+        {
+            conteudo = mapa.conteudo();
+        }
+        else
+        {
+            // Pipes, entrada padrão e arquivos vazios: leitura em fluxo para um buffer único
+            std::ifstream arquivo;
+            std::istream *entrada = &std::cin;
+            if (caminho != "-")
+            {
+                arquivo.open(caminho, std::ios::binary);
+                if (!arquivo.is_open())
+                    return false;
+                entrada = &arquivo;
+            }
+            char bloco[1 << 16];
+            while (entrada->read(bloco, sizeof(bloco)) || entrada->gcount() > 0)
+                buffer.append(bloco, static_cast<std::size_t>(entrada->gcount()));
+            conteudo = buffer;
+        }
+        separar_linhas(conteudo);
+        return true;
+    }
+
+    const std::vector<std::string_view> &linhas() const noexcept
+    {
+        return linhas_lidas;
+    }
+
+private:
+    ArquivoMapeado mapa;
+    std::string buffer;
+    std::vector<std::string_view> linhas_lidas;
+
+    // Procura cada '\n' com memchr (vetorizado pela biblioteca C) e guarda as linhas úteis
+    void separar_linhas(std::string_view conteudo)
+    {
+        // Quase todas as linhas são registros de 81 caracteres + '\n': reserva de acordo
+        linhas_lidas.reserve(conteudo.size() / 82 + 1);
+        const char *atual = conteudo.data();
+        const char *fim = atual + conteudo.size();
+        while (atual < fim)
+        {
+            const char *quebra = static_cast<const char *>(std::memchr(atual, '\n', static_cast<std::size_t>(fim - atual)));
+            const char *fim_linha = quebra ? quebra : fim;
+            std::size_t tamanho = static_cast<std::size_t>(fim_linha - atual);
+            if (tamanho > 0 && atual[tamanho - 1] == '\r')
+                --tamanho;
+            if (tamanho > 0 && atual[0] != '#')
+                linhas_lidas.emplace_back(atual, tamanho);
+            atual = fim_linha + 1;
+        }
+    }
+};
@@ -0,0 +1,460 @@
+// Classificador.hpp
+
+#pragma once
+
+#include <array>   // Para os candidatos e as contagens de técnicas
+#include <cstdint> // Para std::uint8_t e std::uint32_t
+#include <cstddef> // Para std::size_t
+
+#include "Tabuleiro.hpp" // Tabuleiro plano com as máscaras de linha, coluna e região
+
+// Técnicas humanas usadas pelo classificador, da mais fácil para a mais difícil.
+// A ordem é a ordem em que são tentadas: depois de qualquer avanço, volta para a primeira.
+enum class Tecnica : std::uint8_t
+{
+    Nenhuma,        // O tabuleiro já estava completo
+    UnicoEscondido, // Dígito com um só lugar possível na linha, coluna ou região
+    UnicoNu,        // Célula com um só candidato
+    Bloqueio,       // Candidatos de uma região presos numa linha/coluna (ou o contrário)
+    ParNu,          // Duas células de uma unidade com os mesmos dois candidatos
+    XWing,          // Dígito preso em duas colunas em duas linhas (ou o contrário)
+    ParEscondido,   // Dois dígitos que só cabem nas mesmas duas células da unidade
+    TrioNu,         // Três células de uma unidade com só três candidatos entre elas
+    Swordfish,      // X-Wing com três linhas e três colunas
+    TrioEscondido,  // Três dígitos que só cabem nas mesmas três células da unidade
+    Chute,          // Nenhuma técnica acima avança: só resolve com tentativa e erro
+};
+
+constexpr std::size_t NUM_TECNICAS = 11;
+
+// Nome de cada técnica, para mostrar nos resultados
+inline const char *nome_tecnica(Tecnica tecnica) noexcept
+{
+    static const char *const nomes[NUM_TECNICAS] = {
+        "nenhuma", "unico-escondido", "unico-nu", "bloqueio", "par-nu", "x-wing",
+        "par-escondido", "trio-nu", "swordfish", "trio-escondido", "chute"};
+    return nomes[static_cast<std::size_t>(tecnica)];
+}
+
+// Nota de cada técnica, na escala do Sudoku Explainer (1.0 a 10.0), para comparar com outras listas.
+// O chute fica acima de todas as técnicas do classificador.
+inline double nota_tecnica(Tecnica tecnica) noexcept
+{
+    static const double notas[NUM_TECNICAS] = {0.0, 1.5, 2.3, 2.6, 3.0, 3.2, 3.4, 3.6, 3.8, 4.0, 6.0};
+    return notas[static_cast<std::size_t>(tecnica)];
+}
+
+// Resultado da classificação de um quebra-cabeça
+struct Classificacao
+{
+    Tecnica mais_dificil = Tecnica::Nenhuma;          // Técnica mais difícil necessária
+    double nota = 0.0;                                // Nota da técnica mais difícil
+    std::array<std::uint32_t, NUM_TECNICAS> usos{};    // Quantas vezes cada técnica avançou
+};
+
+// Próximo dígito que dá para colocar só com técnicas humanas (para as dicas do jogo)
+struct PassoLogico
+{
+    Tecnica tecnica = Tecnica::Nenhuma; // Técnica mais difícil usada até colocar o dígito
+    std::size_t celula = 81;            // 81 se nenhum dígito foi colocado (completo ou precisa de chute)
+    std::size_t idx_digito = 0;
+};
+
+// Classifica um quebra-cabeça resolvendo-o só com técnicas humanas.
+// A cada passo usa a técnica mais fácil que avança e volta para o começo da escada;
+// a nota é a da técnica mais difícil que foi necessária. Tudo fica em máscaras de bits
+// de tamanho fixo, sem alocação, para classificar lotes grandes rapidamente.
+// O tabuleiro deve ser válido (veja validar_tabuleiro); sem solução única a nota fica sem sentido.
+class Classificador
+{
+public:
+    Classificacao classificar(const Tabuleiro &inicial) noexcept
+    {
+        iniciar(inicial);
+        Classificacao resultado;
+        while (vazios > 0)
+        {
+            Tecnica tecnica = proximo_passo();
+            resultado.usos[static_cast<std::size_t>(tecnica)]++;
+            if (tecnica > resultado.mais_dificil)
+                resultado.mais_dificil = tecnica;
+            if (tecnica == Tecnica::Chute)
+                break; // Daqui em diante seria preciso chutar
+        }
+        resultado.nota = nota_tecnica(resultado.mais_dificil);
+        return resultado;
+    }
+
+    // Sobe a escada a partir do tabuleiro até alguma técnica colocar um dígito e devolve esse dígito,
+    // escolhendo uma célula que já era single antes do último passo (um passo pode colocar vários,
+    // e os seguintes podem depender dos anteriores). Com Tecnica::Chute nenhuma técnica avança.
+    PassoLogico proximo_passo_logico(const Tabuleiro &atual) noexcept
+    {
+        iniciar(atual);
+        PassoLogico passo;
+        while (vazios > 0)
+        {
+            std::array<char, 81> celulas_antes = tab.celulas;
+            std::array<Mascara, 81> cand_antes = cand;
+            int vazios_antes = vazios;
+            Tecnica tecnica = proximo_passo();
+            if (tecnica > passo.tecnica)
+                passo.tecnica = tecnica;
+            if (tecnica == Tecnica::Chute)
+                return passo;
+            if (vazios == vazios_antes)
+                continue; // Só eliminou candidatos
+
+            for (std::size_t celula = 0; celula < 81; ++celula)
+            {
+                if (celulas_antes[celula] == tab.celulas[celula])
+                    continue;
+                std::size_t idx = static_cast<std::size_t>(tab.celulas[celula] - '1');
+                Mascara bit = static_cast<Mascara>(1u << idx);
+                bool single = cand_antes[celula] == bit;
+                for (std::size_t unidade : unidades_da_celula(celula))
+                {
+                    bool unico = true;
+                    for (std::uint8_t outra : UNIDADES[unidade])
+                        unico &= outra == celula || !(cand_antes[outra] & bit);
+                    single |= unico;
+                }
+                if (single)
+                {
+                    passo.celula = celula;
+                    passo.idx_digito = idx;
+                    return passo;
+                }
+            }
+        }
+        return passo;
+    }
+
+    // Tabuleiro como ficou depois da última classificação (completo se não precisou de chute)
+    const Tabuleiro &tabuleiro() const noexcept
+    {
+        return tab;
+    }
+
+private:
+    Tabuleiro tab;
+    std::array<Mascara, 81> cand; // Candidatos de cada célula vazia (0 nas preenchidas)
+    int vazios = 0;
+    bool contradicao = false; // Uma célula ficou sem candidatos (tabuleiro inválido)
+
+    void iniciar(const Tabuleiro &inicial) noexcept
+    {
+        tab = inicial;
+        tab.recalcular_mascaras();
+        vazios = 0;
+        contradicao = false;
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            bool vazia = tab.celulas[celula] == '.';
+            cand[celula] = vazia ? tab.candidatos(celula) : 0;
+            vazios += vazia;
+        }
+    }
+
+    // As três unidades da célula: linha, coluna e região
+    static std::array<std::size_t, 3> unidades_da_celula(std::size_t celula) noexcept
+    {
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        return {linha, 9 + coluna, 18 + obter_regiao(linha, coluna)};
+    }
+
+    // Coloca o dígito e tira o candidato de todas as células das três unidades
+    void colocar(std::size_t celula, std::size_t idx_digito) noexcept
+    {
+        tab.colocar(celula / 9, celula % 9, idx_digito);
+        cand[celula] = 0;
+        --vazios;
+        Mascara bit = static_cast<Mascara>(1u << idx_digito);
+        for (std::size_t unidade : unidades_da_celula(celula))
+        {
+            for (std::uint8_t outra : UNIDADES[unidade])
+                cand[outra] &= static_cast<Mascara>(~bit);
+        }
+    }
+
+    // Tira os dígitos da máscara dos candidatos da célula; retorna true se algo mudou
+    bool eliminar(std::size_t celula, Mascara digitos) noexcept
+    {
+        if (!(cand[celula] & digitos))
+            return false;
+        cand[celula] &= static_cast<Mascara>(~digitos);
+        if (cand[celula] == 0)
+            contradicao = true;
+        return true;
+    }
+
+    // Posições (bits 0..8 dentro da unidade) onde cada dígito ainda é candidato
+    void posicoes(std::size_t unidade, Mascara (&pos)[9]) const noexcept
+    {
+        for (Mascara &p : pos)
+            p = 0;
+        for (std::size_t j = 0; j < 9; ++j)
+        {
+            Mascara c = cand[UNIDADES[unidade][j]];
+            while (c)
+            {
+                pos[__builtin_ctz(c)] |= static_cast<Mascara>(1u << j);
+                c &= static_cast<Mascara>(c - 1);
+            }
+        }
+    }
+
+    // Escolhe itens de 'disponiveis' (bits) até ter n; se a união das máscaras tiver exatamente n bits,
+    // chama aplicar(escolhidos, uniao). Serve para pares/trios nus e escondidos e para os peixes.
+    template <class Aplicar>
+    static bool combinar(const Mascara (&mascaras)[9], Mascara disponiveis, int n, Mascara escolhidos,
+                         Mascara uniao, Aplicar &aplicar) noexcept
+    {
+        if (__builtin_popcount(escolhidos) == n)
+            return __builtin_popcount(uniao) == n && aplicar(escolhidos, uniao);
+        bool mudou = false;
+        while (disponiveis)
+        {
+            std::size_t i = static_cast<std::size_t>(__builtin_ctz(disponiveis));
+            disponiveis &= static_cast<Mascara>(disponiveis - 1);
+            Mascara nova = static_cast<Mascara>(uniao | mascaras[i]);
+            if (__builtin_popcount(nova) <= n)
+                mudou |= combinar(mascaras, disponiveis, n, static_cast<Mascara>(escolhidos | (1u << i)), nova, aplicar);
+        }
+        return mudou;
+    }
+
+    // Itens cuja máscara tem entre 2 e n bits (os únicos que podem entrar num conjunto de tamanho n)
+    static Mascara itens_com_ate(const Mascara (&mascaras)[9], int n) noexcept
+    {
+        Mascara itens = 0;
+        for (std::size_t i = 0; i < 9; ++i)
+        {
+            int bits = __builtin_popcount(mascaras[i]);
+            if (bits >= 2 && bits <= n)
+                itens |= static_cast<Mascara>(1u << i);
+        }
+        return itens;
+    }
+
+    // Um passo da escada: aplica a técnica mais fácil que avança e diz qual foi
+    Tecnica proximo_passo() noexcept
+    {
+        if (!contradicao)
+        {
+            if (unico_escondido())
+                return Tecnica::UnicoEscondido;
+            if (unico_nu())
+                return Tecnica::UnicoNu;
+            if (bloqueio())
+                return Tecnica::Bloqueio;
+            if (subconjunto_nu(2))
+                return Tecnica::ParNu;
+            if (peixe(2))
+                return Tecnica::XWing;
+            if (subconjunto_escondido(2))
+                return Tecnica::ParEscondido;
+            if (subconjunto_nu(3))
+                return Tecnica::TrioNu;
+            if (peixe(3))
+                return Tecnica::Swordfish;
+            if (subconjunto_escondido(3))
+                return Tecnica::TrioEscondido;
+        }
+        return Tecnica::Chute;
+    }
+
+    // Coloca todos os dígitos que só têm um lugar em alguma unidade
+    bool unico_escondido() noexcept
+    {
+        bool mudou = false;
+        for (std::size_t unidade = 0; unidade < 27; ++unidade)
+        {
+            Mascara uma_vez = 0, duas_vezes = 0;
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                duas_vezes |= uma_vez & cand[celula];
+                uma_vez |= cand[celula];
+            }
+            Mascara unicos = static_cast<Mascara>(uma_vez & ~duas_vezes);
+            while (unicos)
+            {
+                std::size_t idx = static_cast<std::size_t>(__builtin_ctz(unicos));
+                unicos &= static_cast<Mascara>(unicos - 1);
+                for (std::uint8_t celula : UNIDADES[unidade])
+                {
+                    if (cand[celula] & (1u << idx))
+                    {
+                        colocar(celula, idx);
+                        mudou = true;
+                        break;
+                    }
+                }
+            }
+        }
+        return mudou;
+    }
+
+    // Coloca todas as células que só têm um candidato
+    bool unico_nu() noexcept
+    {
+        bool mudou = false;
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            Mascara c = cand[celula];
+            if (c && !(c & (c - 1)))
+            {
+                colocar(celula, static_cast<std::size_t>(__builtin_ctz(c)));
+                mudou = true;
+            }
+        }
+        return mudou;
+    }
+
+    // Candidatos bloqueados: se numa região o dígito só aparece numa linha (ou coluna), sai do resto
+    // dessa linha; se numa linha (ou coluna) só aparece numa região, sai do resto da região
+    bool bloqueio() noexcept
+    {
+        static constexpr Mascara TERCOS[3] = {0x007, 0x038, 0x1C0}; // Posições 0-2, 3-5 e 6-8
+        static constexpr Mascara COLUNAS_DA_REGIAO[3] = {0x049, 0x092, 0x124}; // Posições 0,3,6 / 1,4,7 / 2,5,8
+        bool mudou = false;
+        Mascara pos[9];
+
+        // Região -> linha/coluna (pointing)
+        for (std::size_t regiao = 0; regiao < 9; ++regiao)
+        {
+            posicoes(18 + regiao, pos);
+            for (std::size_t idx = 0; idx < 9; ++idx)
+            {
+                if (!pos[idx])
+                    continue;
+                Mascara bit = static_cast<Mascara>(1u << idx);
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    if (!(pos[idx] & ~TERCOS[k]))
+                    {
+                        std::size_t linha = regiao / 3 * 3 + k;
+                        for (std::size_t coluna = 0; coluna < 9; ++coluna)
+                            if (obter_regiao(linha, coluna) != regiao)
+                                mudou |= eliminar(linha * 9 + coluna, bit);
+                    }
+                    if (!(pos[idx] & ~COLUNAS_DA_REGIAO[k]))
+                    {
+                        std::size_t coluna = regiao % 3 * 3 + k;
+                        for (std::size_t linha = 0; linha < 9; ++linha)
+                            if (obter_regiao(linha, coluna) != regiao)
+                                mudou |= eliminar(linha * 9 + coluna, bit);
+                    }
+                }
+            }
+        }
+
+        // Linha/coluna -> região (box-line)
+        for (std::size_t unidade = 0; unidade < 18; ++unidade)
+        {
+            posicoes(unidade, pos);
+            for (std::size_t idx = 0; idx < 9; ++idx)
+            {
+                if (!pos[idx])
+                    continue;
+                Mascara bit = static_cast<Mascara>(1u << idx);
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    if (pos[idx] & ~TERCOS[k])
+                        continue;
+                    // Linha u: os terços são regiões na mesma faixa; coluna u-9: regiões na mesma pilha
+                    std::size_t regiao = unidade < 9 ? unidade / 3 * 3 + k : k * 3 + (unidade - 9) / 3;
+                    for (std::uint8_t celula : UNIDADES[18 + regiao])
+                    {
+                        bool na_unidade = unidade < 9 ? celula / 9 == unidade : celula % 9 == unidade - 9;
+                        if (!na_unidade)
+                            mudou |= eliminar(celula, bit);
+                    }
+                }
+            }
+        }
+        return mudou;
+    }
+
+    // n células de uma unidade com só n candidatos entre elas: esses dígitos saem das outras células
+    bool subconjunto_nu(int n) noexcept
+    {
+        bool mudou = false;
+        for (std::size_t unidade = 0; unidade < 27; ++unidade)
+        {
+            Mascara mascaras[9];
+            for (std::size_t j = 0; j < 9; ++j)
+                mascaras[j] = cand[UNIDADES[unidade][j]];
+            auto aplicar = [&](Mascara celulas, Mascara digitos)
+            {
+                bool eliminou = false;
+                for (std::size_t j = 0; j < 9; ++j)
+                    if (!(celulas & (1u << j)))
+                        eliminou |= eliminar(UNIDADES[unidade][j], digitos);
+                return eliminou;
+            };
+            mudou |= combinar(mascaras, itens_com_ate(mascaras, n), n, 0, 0, aplicar);
+        }
+        return mudou;
+    }
+
+    // n dígitos que só cabem nas mesmas n células da unidade: os outros candidatos saem dessas células
+    bool subconjunto_escondido(int n) noexcept
+    {
+        bool mudou = false;
+        for (std::size_t unidade = 0; unidade < 27; ++unidade)
+        {
+            Mascara pos[9];
+            posicoes(unidade, pos);
+            auto aplicar = [&](Mascara digitos, Mascara celulas)
+            {
+                bool eliminou = false;
+                for (std::size_t j = 0; j < 9; ++j)
+                    if (celulas & (1u << j))
+                        eliminou |= eliminar(UNIDADES[unidade][j], static_cast<Mascara>(~digitos & TODOS_DIGITOS));
+                return eliminou;
+            };
+            mudou |= combinar(pos, itens_com_ate(pos, n), n, 0, 0, aplicar);
+        }
+        return mudou;
+    }
+
+    // Peixe de tamanho n (2 = X-Wing, 3 = Swordfish): se em n linhas o dígito só aparece nas mesmas
+    // n colunas, sai do resto dessas colunas (e o mesmo trocando linhas por colunas)
+    bool peixe(int n) noexcept
+    {
+        bool mudou = false;
+        for (std::size_t idx = 0; idx < 9; ++idx)
+        {
+            Mascara bit = static_cast<Mascara>(1u << idx);
+            for (std::size_t base = 0; base < 18; base += 9) // 0 = linhas como base, 9 = colunas
+            {
+                // mascaras[i] = posições do dígito na linha (ou coluna) i
+                Mascara mascaras[9];
+                for (std::size_t i = 0; i < 9; ++i)
+                {
+                    mascaras[i] = 0;
+                    for (std::size_t j = 0; j < 9; ++j)
+                        if (cand[UNIDADES[base + i][j]] & bit)
+                            mascaras[i] |= static_cast<Mascara>(1u << j);
+                }
+                auto aplicar = [&](Mascara escolhidas, Mascara cobertas)
+                {
+                    bool eliminou = false;
+                    for (std::size_t j = 0; j < 9; ++j)
+                    {
+                        if (!(cobertas & (1u << j)))
+                            continue;
+                        // A unidade cruzada j tem as mesmas posições: a célula i dela está na base i
+                        for (std::size_t i = 0; i < 9; ++i)
+                            if (!(escolhidas & (1u << i)))
+                                eliminou |= eliminar(UNIDADES[base + i][j], bit);
+                    }
+                    return eliminou;
+                };
+                mudou |= combinar(mascaras, itens_com_ate(mascaras, n), n, 0, 0, aplicar);
+            }
+        }
+        return mudou;
+    }
+};
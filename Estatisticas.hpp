@@ -0,0 +1,120 @@
+// Estatisticas.hpp
+
+#pragma once
+
+#include <chrono>  // Para medir o tempo de validação e de busca
+#include <cstdint> // Para std::uint64_t
+#include <cstdio>  // Para formatar os tempos (snprintf)
+#include <string>  // Para o JSON
+
+// Políticas de estatísticas do solucionador, no mesmo esquema das políticas de rastreio:
+// a política é um parâmetro de template de Solucao e a versão nula some na compilação.
+// Eventos:
+//   no:         o solucionador entrou num nó da busca, na profundidade dada (número de chutes acima dele)
+//   chute:      um dígito foi tentado numa célula com mais de um candidato
+//   retrocesso: o chute não levou a uma solução
+//   propagado:  a propagação colocou um dígito forçado (single), eliminando-o da linha, coluna e região
+//   iniciar/terminar_validacao e iniciar/terminar_busca: delimitam o tempo de cada fase
+
+// Não conta nada: todas as chamadas são vazias e o compilador as elimina
+struct EstatisticasNulas
+{
+    void no(std::size_t) noexcept {}
+    void chute() noexcept {}
+    void retrocesso() noexcept {}
+    void propagado() noexcept {}
+    void iniciar_validacao() noexcept {}
+    void terminar_validacao() noexcept {}
+    void iniciar_busca() noexcept {}
+    void terminar_busca() noexcept {}
+};
+
+// Conta os eventos e mede o tempo de cada fase. Cada thread usa a sua (dentro do seu Solucao),
+// então não há nenhuma sincronização; os totais são somados no final com somar.
+struct EstatisticasBusca
+{
+    std::uint64_t nos = 0;
+    std::uint64_t chutes = 0;
+    std::uint64_t retrocessos = 0;
+    std::uint64_t propagados = 0;
+    std::uint64_t profundidade_maxima = 0;
+    double segundos_validacao = 0.0;
+    double segundos_busca = 0.0;
+
+    void no(std::size_t profundidade) noexcept
+    {
+        ++nos;
+        if (profundidade > profundidade_maxima)
+            profundidade_maxima = profundidade;
+    }
+
+    void chute() noexcept
+    {
+        ++chutes;
+    }
+
+    void retrocesso() noexcept
+    {
+        ++retrocessos;
+    }
+
+    void propagado() noexcept
+    {
+        ++propagados;
+    }
+
+    void iniciar_validacao() noexcept
+    {
+        inicio = std::chrono::steady_clock::now();
+    }
+
+    void terminar_validacao() noexcept
+    {
+        segundos_validacao += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    void iniciar_busca() noexcept
+    {
+        inicio = std::chrono::steady_clock::now();
+    }
+
+    void terminar_busca() noexcept
+    {
+        segundos_busca += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Volta tudo a zero (por exemplo, antes de cada quebra-cabeça)
+    void zerar() noexcept
+    {
+        *this = EstatisticasBusca();
+    }
+
+    // Acumula outra medida: soma os contadores e os tempos, e fica com a maior profundidade
+    void somar(const EstatisticasBusca &outra) noexcept
+    {
+        nos += outra.nos;
+        chutes += outra.chutes;
+        retrocessos += outra.retrocessos;
+        propagados += outra.propagados;
+        if (outra.profundidade_maxima > profundidade_maxima)
+            profundidade_maxima = outra.profundidade_maxima;
+        segundos_validacao += outra.segundos_validacao;
+        segundos_busca += outra.segundos_busca;
+    }
+
+    // Acrescenta os campos em JSON, sem as chaves, para quem chama juntar outros campos ao objeto
+    void escrever_campos_json(std::string &saida) const
+    {
+        char tempos[96];
+        std::snprintf(tempos, sizeof(tempos), "\"validacao_us\": %.3f, \"busca_us\": %.3f",
+                      segundos_validacao * 1e6, segundos_busca * 1e6);
+        saida += "\"nos\": " + std::to_string(nos) + ", \"chutes\": " + std::to_string(chutes) +
+                 ", \"retrocessos\": " + std::to_string(retrocessos) +
+                 ", \"profundidade_maxima\": " + std::to_string(profundidade_maxima) +
+                 ", \"propagados\": " + std::to_string(propagados) + ", ";
+        saida += tempos;
+    }
+
+private:
+    std::chrono::steady_clock::time_point inicio;
+};
@@ -0,0 +1,371 @@
+// ExecutorParalelo.hpp
+
+#pragma once
+
+#include <vector>  // Para guardar as filas e as threads
+#include <deque>   // Para guardar as filas de cada thread
+#include <thread>  // Para criar as threads de trabalho
+#include <mutex>   // Para proteger cada fila de blocos
+#include <condition_variable> // Para avisar o escritor que um bloco terminou e esperar na fila limitada
+#include <string>  // Para o texto de cada bloco
+#include <ostream> // Para a saída do escritor
+#include <functional> // Para o destino dos textos do escritor
+#include <cstddef> // Para std::size_t
+#include <cstdint> // Para o número da rodada do grupo de threads
+
+// Quantidade de threads padrão: todos os núcleos disponíveis (ou 1 se não for possível descobrir)
+inline unsigned threads_disponiveis() noexcept
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Fila de blocos de uma thread: a dona tira do início, as outras roubam do fim
+struct FilaBlocos
+{
+    std::mutex trava;
+    std::size_t inicio = 0;
+    std::size_t fim = 0;
+
+    // A própria thread pega o próximo bloco da sua faixa
+    bool pegar(std::size_t &bloco)
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        if (inicio == fim)
+            return false;
+        bloco = inicio++;
+        return true;
+    }
+
+    // Outra thread rouba o último bloco da faixa
+    bool roubar(std::size_t &bloco)
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        if (inicio == fim)
+            return false;
+        bloco = --fim;
+        return true;
+    }
+};
+
+// Divide os blocos [0, num_blocos) em faixas contíguas, uma por fila
+inline void dividir_faixas(std::deque<FilaBlocos> &filas, std::size_t num_blocos)
+{
+    std::size_t num_filas = filas.size();
+    for (std::size_t t = 0; t < num_filas; ++t)
+    {
+        filas[t].inicio = num_blocos * t / num_filas;
+        filas[t].fim = num_blocos * (t + 1) / num_filas;
+    }
+}
+
+// Trabalho da thread 'id': esvazia a própria fila e depois rouba das outras, começando pela vizinha,
+// até não sobrar bloco em nenhuma
+template <class Tarefa>
+void trabalhar_blocos(std::deque<FilaBlocos> &filas, unsigned id, Tarefa &tarefa)
+{
+    unsigned num_threads = static_cast<unsigned>(filas.size());
+    std::size_t bloco;
+    for (;;)
+    {
+        // Primeiro esvazia a própria fila
+        while (filas[id].pegar(bloco))
+            tarefa(bloco, id);
+
+        // Depois tenta roubar das outras, começando pela vizinha
+        bool roubou = false;
+        for (unsigned passo = 1; passo < num_threads && !roubou; ++passo)
+        {
+            unsigned vitima = (id + passo) % num_threads;
+            if (filas[vitima].roubar(bloco))
+            {
+                tarefa(bloco, id);
+                roubou = true;
+            }
+        }
+        // Se não há nada para roubar, todo o trabalho já foi distribuído
+        if (!roubou)
+            return;
+    }
+}
+
+// Executa tarefa(bloco, id_thread) para cada bloco em [0, num_blocos) usando num_threads threads.
+// Cada thread começa com uma faixa contígua de blocos; quando a sua acaba, rouba blocos das outras.
+// Assim os blocos difíceis não deixam núcleos parados como aconteceria com uma divisão fixa.
+template <class Tarefa>
+void executar_blocos(std::size_t num_blocos, unsigned num_threads, Tarefa &&tarefa)
+{
+    if (num_threads == 0)
+        num_threads = 1;
+
+    // Divide os blocos em faixas contíguas, uma por thread
+    std::deque<FilaBlocos> filas(num_threads);
+    dividir_faixas(filas, num_blocos);
+
+    // A thread que chamou também trabalha como a thread 0
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; ++t)
+        threads.emplace_back([&, t]
+                             { trabalhar_blocos(filas, t, tarefa); });
+    trabalhar_blocos(filas, 0, tarefa);
+    for (auto &th : threads)
+        th.join();
+}
+
+// Threads fixas para rodar executar_blocos muitas vezes seguidas (por exemplo, uma vez por quebra-cabeça).
+// As threads são criadas no construtor e juntadas no destrutor; entre uma rodada e outra ficam esperando,
+// então cada rodada custa só acordá-las, sem criar nem juntar threads. Uma rodada por vez: executar não
+// pode ser chamada de duas threads ao mesmo tempo.
+class GrupoThreads
+{
+public:
+    explicit GrupoThreads(unsigned num_threads) : filas(num_threads == 0 ? 1 : num_threads)
+    {
+        // A thread que chama executar trabalha como a thread 0
+        for (unsigned t = 1; t < filas.size(); ++t)
+            threads.emplace_back([this, t]
+                                 { esperar_rodadas(t); });
+    }
+
+    GrupoThreads(const GrupoThreads &) = delete;
+    GrupoThreads &operator=(const GrupoThreads &) = delete;
+
+    ~GrupoThreads()
+    {
+        {
+            std::lock_guard<std::mutex> guarda(trava);
+            encerrar = true;
+        }
+        com_rodada.notify_all();
+        for (auto &th : threads)
+            th.join();
+    }
+
+    unsigned tamanho() const noexcept
+    {
+        return static_cast<unsigned>(filas.size());
+    }
+
+    // Mesmo contrato de executar_blocos, com as threads do grupo; volta quando todos os blocos terminaram
+    template <class Tarefa>
+    void executar(std::size_t num_blocos, Tarefa &&tarefa)
+    {
+        dividir_faixas(filas, num_blocos);
+        auto trabalhar = [&](unsigned id)
+        {
+            trabalhar_blocos(filas, id, tarefa);
+        };
+        if (!threads.empty())
+        {
+            {
+                std::lock_guard<std::mutex> guarda(trava);
+                trabalho = [](void *dados, unsigned id)
+                {
+                    (*static_cast<decltype(trabalhar) *>(dados))(id);
+                };
+                contexto = &trabalhar;
+                ativas = threads.size();
+                ++rodada;
+            }
+            com_rodada.notify_all();
+        }
+        trabalhar(0);
+        std::unique_lock<std::mutex> guarda(trava);
+        rodada_terminou.wait(guarda, [&]
+                             { return ativas == 0; });
+    }
+
+private:
+    std::deque<FilaBlocos> filas; // Uma por thread, reaproveitadas em todas as rodadas
+    std::vector<std::thread> threads;
+    std::mutex trava;
+    std::condition_variable com_rodada;
+    std::condition_variable rodada_terminou;
+    std::uint64_t rodada = 0;
+    std::size_t ativas = 0; // Threads do grupo que ainda não terminaram a rodada atual
+    bool encerrar = false;
+    void (*trabalho)(void *, unsigned) = nullptr; // Trabalho da rodada atual, sem alocar um std::function
+    void *contexto = nullptr;
+
+    void esperar_rodadas(unsigned id)
+    {
+        std::uint64_t vista = 0;
+        for (;;)
+        {
+            void (*funcao)(void *, unsigned);
+            void *dados;
+            {
+                std::unique_lock<std::mutex> guarda(trava);
+                com_rodada.wait(guarda, [&]
+                                { return encerrar || rodada != vista; });
+                if (encerrar)
+                    return;
+                vista = rodada;
+                funcao = trabalho;
+                dados = contexto;
+            }
+            funcao(dados, id);
+            {
+                std::lock_guard<std::mutex> guarda(trava);
+                if (--ativas != 0)
+                    continue;
+            }
+            rodada_terminou.notify_one();
+        }
+    }
+};
+
+// Fila com capacidade máxima entre quem recebe os pedidos e as threads que os atendem.
+// Quem coloca espera enquanto a fila está cheia, então um cliente rápido não faz a memória crescer sem limite.
+template <class T>
+class FilaLimitada
+{
+public:
+    explicit FilaLimitada(std::size_t capacidade_maxima) : capacidade(capacidade_maxima == 0 ? 1 : capacidade_maxima) {}
+
+    // Espera ter espaço e coloca o item; retorna false se a fila já foi fechada
+    bool colocar(T &&item)
+    {
+        {
+            std::unique_lock<std::mutex> guarda(trava);
+            com_espaco.wait(guarda, [&]
+                            { return fechada || itens.size() < capacidade; });
+            if (fechada)
+                return false;
+            itens.push_back(std::move(item));
+        }
+        com_itens.notify_one();
+        return true;
+    }
+
+    // Espera ter um item e o tira; retorna false quando a fila foi fechada e esvaziada
+    bool tirar(T &item)
+    {
+        {
+            std::unique_lock<std::mutex> guarda(trava);
+            com_itens.wait(guarda, [&]
+                           { return fechada || !itens.empty(); });
+            if (itens.empty())
+                return false;
+            item = std::move(itens.front());
+            itens.pop_front();
+        }
+        com_espaco.notify_one();
+        return true;
+    }
+
+    // Coloca de volta, no final, um item que já tinha sido tirado (por exemplo, um pedido que só foi atendido
+    // em parte). Não espera espaço nem olha se a fila foi fechada: quem devolve é quem tira, então esperar
+    // aqui poderia travar todas as threads, e o item já tinha sido aceito antes.
+    void devolver(T &&item)
+    {
+        {
+            std::lock_guard<std::mutex> guarda(trava);
+            itens.push_back(std::move(item));
+        }
+        com_itens.notify_one();
+    }
+
+    // Não aceita mais itens; os que já estão na fila ainda podem ser tirados
+    void fechar()
+    {
+        {
+            std::lock_guard<std::mutex> guarda(trava);
+            fechada = true;
+        }
+        com_itens.notify_all();
+        com_espaco.notify_all();
+    }
+
+private:
+    std::size_t capacidade;
+    std::deque<T> itens;
+    bool fechada = false;
+    std::mutex trava;
+    std::condition_variable com_itens;
+    std::condition_variable com_espaco;
+};
+
+// Recebe, na ordem dos blocos, o texto pronto de cada um
+using DestinoTexto = std::function<void(const std::string &)>;
+
+// Escreve o texto de cada bloco na ordem dos blocos, numa thread própria, assim que ele fica pronto.
+// Os blocos podem terminar em qualquer ordem; a saída sempre sai na ordem da entrada.
+class EscritorOrdenado
+{
+public:
+    // Com saida nula, os textos entregues são descartados
+    EscritorOrdenado(std::ostream *saida_destino, std::size_t num_blocos)
+        : EscritorOrdenado(saida_destino ? DestinoTexto([saida_destino](const std::string &texto)
+                                                        { saida_destino->write(texto.data(), static_cast<std::streamsize>(texto.size())); })
+                                         : DestinoTexto(),
+                           saida_destino, num_blocos)
+    {
+    }
+
+    // Entrega cada texto a uma função em vez de um fluxo (por exemplo, para gravar em binário);
+    // com destino vazio, os textos entregues são descartados
+    EscritorOrdenado(DestinoTexto destino_textos, std::size_t num_blocos)
+        : EscritorOrdenado(std::move(destino_textos), nullptr, num_blocos)
+    {
+    }
+
+    ~EscritorOrdenado()
+    {
+        finalizar();
+    }
+
+    // Entrega o texto pronto de um bloco (pode ser chamada de qualquer thread)
+    void entregar(std::size_t bloco, std::string &&texto)
+    {
+        if (!destino)
+            return;
+        {
+            std::lock_guard<std::mutex> guarda(trava);
+            textos[bloco] = std::move(texto);
+            concluido[bloco] = 1;
+        }
+        sinal.notify_one();
+    }
+
+    // Espera todos os blocos serem escritos (todos precisam ter sido entregues)
+    void finalizar()
+    {
+        if (escritor.joinable())
+            escritor.join();
+    }
+
+private:
+    DestinoTexto destino;
+    std::ostream *saida; // Só para o flush no final, quando o destino é um fluxo
+    std::vector<std::string> textos;
+    std::vector<char> concluido;
+    std::mutex trava;
+    std::condition_variable sinal;
+    std::thread escritor;
+
+    EscritorOrdenado(DestinoTexto destino_textos, std::ostream *saida_destino, std::size_t num_blocos)
+        : destino(std::move(destino_textos)), saida(saida_destino), textos(num_blocos), concluido(num_blocos, 0)
+    {
+        if (destino)
+            escritor = std::thread([this]
+                                   { escrever(); });
+    }
+
+    void escrever()
+    {
+        for (std::size_t bloco = 0; bloco < textos.size(); ++bloco)
+        {
+            std::string texto;
+            {
+                std::unique_lock<std::mutex> guarda(trava);
+                sinal.wait(guarda, [&]
+                           { return concluido[bloco] != 0; });
+                texto.swap(textos[bloco]); // Libera a memória do bloco já escrito
+            }
+            destino(texto);
+        }
+        if (saida)
+            saida->flush();
+    }
+};
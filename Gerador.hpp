@@ -0,0 +1,177 @@
+// Gerador.hpp
+
+#pragma once
+
+#include <array>   // Para a ordem de remoção e os dígitos embaralhados
+#include <cstdint> // Para std::uint8_t
+
+#include "Tabuleiro.hpp" // Tabuleiro plano de 81 células com máscaras
+#include "Solucao.hpp"   // Solucionador com propagação, usado para garantir solução única
+#include "Aleatorio.hpp" // Gerador xoshiro256** rápido e reproduzível
+
+// Classe responsável por preencher um Sudoku com dígitos em ordem aleatória, usando backtracking
+class SolucaoAleatoria
+{
+public:
+    // O gerador é de quem chama: assim cada thread usa o seu e nada é criado a cada célula
+    explicit SolucaoAleatoria(GeradorRapido &gerador_usado) noexcept : gerador(gerador_usado) {}
+
+    // Função principal que resolve o Sudoku
+    void resolverSudoku(Tabuleiro &tabuleiro) noexcept
+    {
+        // Inicializa as máscaras com os valores já presentes no tabuleiro
+        tabuleiro.recalcular_mascaras();
+        // Chama o solucionador recursivo a partir da célula 0
+        resolver(tabuleiro, 0);
+    }
+
+private:
+    GeradorRapido &gerador;
+
+    // Função que encontra a próxima célula vazia a partir de uma posição (81 se não houver)
+    static std::size_t proxima_posicao_vazia(const Tabuleiro &tabuleiro, std::size_t celula) noexcept
+    {
+        while (celula != 81 && tabuleiro.celulas[celula] != '.') // Percorre até o final do tabuleiro
+        {
+            ++celula;
+        }
+        return celula;
+    }
+
+    // Função recursiva de backtracking que preenche o tabuleiro
+    bool resolver(Tabuleiro &tabuleiro, std::size_t celula_inicio) noexcept
+    {
+        // Encontra a próxima célula vazia
+        std::size_t celula = proxima_posicao_vazia(tabuleiro, celula_inicio);
+
+        // Se percorreu todo o tabuleiro, a solução está completa
+        if (celula == 81)
+        {
+            return true;
+        }
+
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        // Gera uma máscara que indica quais dígitos já estão presentes na linha, coluna ou região
+        Mascara contem = tabuleiro.contem(linha, coluna);
+        // Se todos os números já estão presentes, não é possível preencher essa célula
+        if (contem == TODOS_DIGITOS)
+        {
+            return false;
+        }
+
+        // Índices dos dígitos possíveis (0-8, que representam '1'-'9'), na pilha para não alocar
+        std::array<std::uint8_t, 9> digitos{0, 1, 2, 3, 4, 5, 6, 7, 8};
+        // Embaralha a ordem dos dígitos para variar a geração do tabuleiro
+        embaralhar(digitos.data(), digitos.size(), gerador);
+
+        // Tenta todos os dígitos possíveis na célula
+        for (std::size_t idx_digito : digitos)
+        {
+            if (!(contem & (1u << idx_digito))) // Se esse dígito ainda não foi usado
+            {
+                tabuleiro.colocar(linha, coluna, idx_digito); // Preenche a célula e marca nas máscaras
+                // Chama recursivamente para próxima célula
+                if (resolver(tabuleiro, celula))
+                {
+                    return true; // Se resolveu, retorna true
+                }
+                // Se não resolveu, desfaz (backtracking)
+                tabuleiro.remover(linha, coluna, idx_digito);
+            }
+        }
+        // Nenhum dígito funcionou, retorna false
+        return false;
+    }
+};
+
+// Verifica se, depois de esvaziar a célula que tinha o dígito (índice 0..8), a solução continua única.
+// O tabuleiro tinha solução única com a pista; então basta procurar alguma solução com outro dígito
+// nessa célula. Cada busca para na primeira solução e a propagação corta quase todos os ramos logo,
+// o que sai bem mais barato do que contar as soluções do tabuleiro inteiro de novo.
+template <class Rastreio, class Estatisticas>
+bool continua_unica(Solucao<Rastreio, Estatisticas> &solucao, const Tabuleiro &tabuleiro, std::size_t linha,
+                    std::size_t coluna, std::size_t idx_digito)
+{
+    Mascara outros = static_cast<Mascara>(tabuleiro.candidatos(linha * 9 + coluna) & ~(1u << idx_digito));
+    while (outros)
+    {
+        std::size_t outro = static_cast<std::size_t>(__builtin_ctz(outros));
+        outros &= static_cast<Mascara>(outros - 1);
+        Tabuleiro copia = tabuleiro;
+        copia.colocar(linha, coluna, outro);
+        if (solucao.resolverSudoku(copia))
+            return false; // Achou uma segunda solução
+    }
+    return true;
+}
+
+// Função para gerar um tabuleiro de Sudoku completo e depois remover células, mantendo a solução única.
+// Nem sempre dá para chegar a 'num_vazios' (quebra-cabeças com solução única têm pelo menos 17 pistas);
+// nesse caso tenta outras soluções completas e devolve o tabuleiro com mais células vazias.
+// O resultado depende só do estado do gerador, então a mesma semente gera o mesmo tabuleiro.
+// As estatísticas de 'solucao' (se houver) acumulam todas as buscas feitas para garantir a unicidade.
+template <class Rastreio, class Estatisticas>
+Tabuleiro gerar_tabuleiro_aleatorio(int num_vazios, GeradorRapido &gerador, Solucao<Rastreio, Estatisticas> &solucao)
+{
+    Tabuleiro melhor;
+    int vazios_melhor = -1;
+
+    const int tentativas = 20;
+    for (int tentativa = 0; tentativa < tentativas && vazios_melhor < num_vazios; ++tentativa)
+    {
+        // Inicializa o tabuleiro vazio e preenche com uma solução válida
+        Tabuleiro tabuleiro;
+        SolucaoAleatoria(gerador).resolverSudoku(tabuleiro);
+
+        // Tenta esvaziar as células em ordem aleatória, desfazendo as remoções que quebram a unicidade
+        std::array<std::size_t, 81> ordem;
+        for (std::size_t i = 0; i < 81; ++i)
+            ordem[i] = i;
+        embaralhar(ordem.data(), ordem.size(), gerador);
+
+        int vazios = 0;
+        for (std::size_t i = 0; i < 81 && vazios < num_vazios; ++i)
+        {
+            std::size_t linha = ordem[i] / 9, coluna = ordem[i] % 9;
+            std::size_t idx_digito = static_cast<std::size_t>(tabuleiro(linha, coluna) - '1');
+            tabuleiro.remover(linha, coluna, idx_digito);
+            if (continua_unica(solucao, tabuleiro, linha, coluna, idx_digito))
+                ++vazios;
+            else
+                tabuleiro.colocar(linha, coluna, idx_digito); // Desfaz a remoção
+        }
+
+        if (vazios > vazios_melhor)
+        {
+            melhor = tabuleiro;
+            vazios_melhor = vazios;
+        }
+    }
+    // Retorna o tabuleiro com células removidas
+    return melhor;
+}
+
+// Conta as células vazias do tabuleiro
+inline int contar_vazios(const Tabuleiro &tabuleiro)
+{
+    int vazios = 0;
+    for (char c : tabuleiro.celulas)
+        vazios += (c == '.');
+    return vazios;
+}
+
+// Número de células vazias de cada nível de dificuldade (1 - Fácil, 2 - Médio, 3 - Difícil)
+inline int vazios_da_dificuldade(int dificuldade)
+{
+    switch (dificuldade)
+    {
+    case 1:
+        return 20; // Fácil
+    case 2:
+        return 40; // Médio
+    case 3:
+        return 60; // Difícil
+    default:
+        return 30; // Padrão caso digite errado
+    }
+}
@@ -0,0 +1,269 @@
+// Jogo.hpp
+
+#pragma once
+
+#include <array>   // Para as contagens por unidade e as células fixas
+#include <cstdint> // Para std::uint8_t
+#include <string>  // Para o motivo de um quebra-cabeça não servir
+#include <vector>  // Para o histórico de jogadas
+
+#include "Tabuleiro.hpp"     // Tabuleiro plano de 81 células
+#include "Solucao.hpp"       // Validação e solução feitas uma vez, no início
+#include "Classificador.hpp" // Técnicas humanas para as dicas
+
+// Resultado de uma jogada
+enum class ResultadoJogada : std::uint8_t
+{
+    Aceita,   // Jogada feita sem repetir dígito na linha, coluna ou região
+    Conflito, // Jogada feita, mas o dígito ficou repetido em alguma unidade
+    Fixa,     // A célula é uma pista do quebra-cabeça e não muda
+    Invalida, // Posição fora do tabuleiro ou caractere que não é '.' nem '1'..'9'
+};
+
+// Dica para o jogador: o dígito de uma célula e a técnica que leva até ele.
+// Com corrigir, a célula já tem um dígito errado e digito é o certo.
+struct Dica
+{
+    std::size_t celula = 81; // 81 se não há dica (tabuleiro completo e certo)
+    char digito = '.';
+    Tecnica tecnica = Tecnica::Nenhuma;
+    bool corrigir = false;
+};
+
+// Estado de uma partida, atualizado a cada jogada em O(1): contagem de cada dígito em cada unidade
+// (para os candidatos e os conflitos), quantas células estão vazias ou erradas e o histórico para desfazer.
+// A validação e a solução são feitas uma vez só, em iniciar; depois nenhuma jogada refaz a busca.
+class Jogo
+{
+public:
+    // Começa uma partida; retorna o motivo se o quebra-cabeça não servir (inválido ou sem solução),
+    // ou vazio se está tudo certo. Com mais de uma solução (veja solucao_unica), os erros, as dicas e
+    // consistente usam a primeira solução encontrada.
+    std::string iniciar(const Tabuleiro &inicial)
+    {
+        std::string motivo = validar_tabuleiro(inicial);
+        if (!motivo.empty())
+            return motivo;
+        Solucao<> solucionador;
+        Tabuleiro resolvido = inicial;
+        if (!solucionador.resolverSudoku(resolvido))
+            return "Não existe solução para o tabuleiro de Sudoku informado!";
+        unica = solucionador.contarSolucoes(inicial, 2) == 1;
+
+        solucao = resolvido;
+        tab = inicial;
+        contagem = {};
+        contem.fill(0);
+        repetidos = 0;
+        erradas = 0;
+        vazias = 0;
+        historico.clear();
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            fixas[celula] = inicial.celulas[celula] != '.';
+            if (fixas[celula])
+                contar(celula, inicial.celulas[celula], +1);
+            else
+                ++vazias;
+        }
+        return "";
+    }
+
+    // Coloca o dígito ('1'..'9') na célula, ou a esvazia com '.'
+    ResultadoJogada jogar(std::size_t linha, std::size_t coluna, char digito)
+    {
+        if (linha >= 9 || coluna >= 9 || (digito != '.' && (digito < '1' || digito > '9')))
+            return ResultadoJogada::Invalida;
+        std::size_t celula = linha * 9 + coluna;
+        if (fixas[celula])
+            return ResultadoJogada::Fixa;
+        historico.push_back({static_cast<std::uint8_t>(celula), tab.celulas[celula]});
+        trocar(celula, digito);
+        return digito != '.' && repetido(celula, digito) ? ResultadoJogada::Conflito : ResultadoJogada::Aceita;
+    }
+
+    // Desfaz a última jogada; retorna false se não há nada para desfazer
+    bool desfazer()
+    {
+        if (historico.empty())
+            return false;
+        Jogada jogada = historico.back();
+        historico.pop_back();
+        trocar(jogada.celula, jogada.anterior);
+        return true;
+    }
+
+    // Dígitos que não aparecem na linha, coluna nem região da célula
+    Mascara candidatos(std::size_t celula) const noexcept
+    {
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        return static_cast<Mascara>(~(contem[linha] | contem[9 + coluna] | contem[18 + obter_regiao(linha, coluna)]) &
+                                    TODOS_DIGITOS);
+    }
+
+    // A jogada combina com a solução (única, se solucao_unica)?
+    bool consistente(std::size_t linha, std::size_t coluna, char digito) const noexcept
+    {
+        return linha < 9 && coluna < 9 && solucao(linha, coluna) == digito;
+    }
+
+    // Próxima dica: primeiro aponta uma célula errada; senão, o próximo dígito que dá para achar com
+    // técnicas humanas a partir do tabuleiro atual. Se nenhuma técnica avança, entrega o dígito da célula
+    // com menos candidatos (Tecnica::Chute).
+    Dica dica()
+    {
+        Dica resultado;
+        if (erradas > 0)
+        {
+            for (std::size_t celula = 0; celula < 81; ++celula)
+            {
+                if (tab.celulas[celula] != '.' && tab.celulas[celula] != solucao.celulas[celula])
+                {
+                    resultado.celula = celula;
+                    resultado.digito = solucao.celulas[celula];
+                    resultado.corrigir = true;
+                    return resultado;
+                }
+            }
+        }
+        if (vazias == 0)
+            return resultado;
+
+        PassoLogico passo = classificador.proximo_passo_logico(tab);
+        resultado.tecnica = passo.tecnica;
+        resultado.celula = passo.celula;
+        if (resultado.celula == 81)
+        {
+            // Nenhuma técnica avança: a célula vazia com menos candidatos
+            int menor = 10;
+            for (std::size_t celula = 0; celula < 81; ++celula)
+            {
+                int quantidade = __builtin_popcount(candidatos(celula));
+                if (tab.celulas[celula] == '.' && quantidade < menor)
+                {
+                    menor = quantidade;
+                    resultado.celula = celula;
+                }
+            }
+        }
+        resultado.digito = solucao.celulas[resultado.celula];
+        return resultado;
+    }
+
+    // Unidades com algum dígito repetido (contando cada repetição)
+    int conflitos() const noexcept
+    {
+        return repetidos;
+    }
+
+    // Células preenchidas pelo jogador com um dígito diferente da solução
+    int erros() const noexcept
+    {
+        return erradas;
+    }
+
+    int celulas_vazias() const noexcept
+    {
+        return vazias;
+    }
+
+    bool resolvido() const noexcept
+    {
+        return vazias == 0 && erradas == 0;
+    }
+
+    bool solucao_unica() const noexcept
+    {
+        return unica;
+    }
+
+    bool fixa(std::size_t celula) const noexcept
+    {
+        return fixas[celula];
+    }
+
+    // Tabuleiro atual (só as células; as máscaras não são mantidas, veja candidatos)
+    const Tabuleiro &tabuleiro() const noexcept
+    {
+        return tab;
+    }
+
+private:
+    struct Jogada
+    {
+        std::uint8_t celula;
+        char anterior;
+    };
+
+    Tabuleiro tab;
+    Tabuleiro solucao;
+    bool unica = true;
+    std::array<bool, 81> fixas{};
+    std::array<std::array<std::uint8_t, 9>, 27> contagem{}; // Quantas vezes cada dígito aparece na unidade
+    std::array<Mascara, 27> contem{};                     // Dígitos com contagem maior que zero
+    int repetidos = 0;
+    int erradas = 0;
+    int vazias = 0;
+    std::vector<Jogada> historico;
+    Classificador classificador;
+
+    // As três unidades da célula: linha, coluna e região
+    static std::array<std::size_t, 3> unidades(std::size_t celula) noexcept
+    {
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        return {linha, 9 + coluna, 18 + obter_regiao(linha, coluna)};
+    }
+
+    // Soma (+1) ou tira (-1) o dígito das contagens das três unidades da célula
+    void contar(std::size_t celula, char digito, int delta) noexcept
+    {
+        std::size_t idx = static_cast<std::size_t>(digito - '1');
+        Mascara bit = static_cast<Mascara>(1u << idx);
+        for (std::size_t unidade : unidades(celula))
+        {
+            std::uint8_t &n = contagem[unidade][idx];
+            if (delta > 0)
+            {
+                repetidos += n > 0;
+                ++n;
+                contem[unidade] |= bit;
+            }
+            else
+            {
+                --n;
+                repetidos -= n > 0;
+                if (n == 0)
+                    contem[unidade] &= static_cast<Mascara>(~bit);
+            }
+        }
+    }
+
+    // O dígito aparece mais de uma vez em alguma unidade da célula?
+    bool repetido(std::size_t celula, char digito) const noexcept
+    {
+        std::size_t idx = static_cast<std::size_t>(digito - '1');
+        for (std::size_t unidade : unidades(celula))
+            if (contagem[unidade][idx] > 1)
+                return true;
+        return false;
+    }
+
+    // Troca o conteúdo de uma célula do jogador, atualizando contagens, vazias e erradas
+    void trocar(std::size_t celula, char digito) noexcept
+    {
+        char anterior = tab.celulas[celula];
+        if (anterior != '.')
+        {
+            contar(celula, anterior, -1);
+            erradas -= anterior != solucao.celulas[celula];
+            ++vazias;
+        }
+        tab.celulas[celula] = digito;
+        if (digito != '.')
+        {
+            contar(celula, digito, +1);
+            erradas += digito != solucao.celulas[celula];
+            --vazias;
+        }
+    }
+};
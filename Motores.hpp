@@ -0,0 +1,136 @@
+// Motores.hpp
+
+#pragma once
+
+#include <cstring> // Para comparar nomes de motores
+#include <memory>  // Para os motores, criados só quando são os escolhidos
+#include <string>  // Para o motivo da validação
+
+#include "Tabuleiro.hpp"  // Tabuleiro plano com as máscaras de linha, coluna e região
+#include "Solucao.hpp"    // Propagação de restrições + backtracking
+#include "SolucaoDLX.hpp" // Cobertura exata com Dancing Links
+#include "SolucaoSimd.hpp" // Núcleo vetorizado (AVX2/SSE4.1/portável)
+#include "BuscaParalela.hpp" // Um tabuleiro dividido entre várias threads
+#include "SolucaoIntercalada.hpp" // 16 tabuleiros avançando juntos num núcleo só
+
+// Motores de resolução disponíveis
+enum class Motor
+{
+    Propagacao,
+    DLX,
+    Simd,
+    Paralelo,
+    Intercalado,
+};
+
+// Todos os motores, na ordem em que aparecem na linha de comando e nos benchmarks
+constexpr Motor TODOS_MOTORES[] = {Motor::Propagacao, Motor::DLX, Motor::Simd, Motor::Paralelo, Motor::Intercalado};
+
+// Nome usado na linha de comando para cada motor
+inline const char *nome_motor(Motor motor) noexcept
+{
+    switch (motor)
+    {
+    case Motor::DLX:
+        return "dlx";
+    case Motor::Simd:
+        return "simd";
+    case Motor::Paralelo:
+        return "paralelo";
+    case Motor::Intercalado:
+        return "intercalado";
+    default:
+        return "propagacao";
+    }
+}
+
+// Converte o nome da linha de comando no motor; retorna false se o nome não existir
+inline bool ler_motor(const char *nome, Motor &motor) noexcept
+{
+    for (Motor m : TODOS_MOTORES)
+    {
+        if (std::strcmp(nome, nome_motor(m)) == 0)
+        {
+            motor = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Solucionador de uma thread: cria só o motor escolhido em tempo de execução e guarda o estado dele
+// (o DLX guarda uns 80 KB de nós, o intercalado uns 2,6 KB e o paralelo tem as suas próprias threads,
+// threads_paralelo incluindo a que chama). Um Solucionador pode ser movido, mas não copiado.
+class Solucionador
+{
+public:
+    explicit Solucionador(Motor motor_escolhido = Motor::Propagacao, unsigned threads_paralelo = threads_disponiveis())
+        : motor(motor_escolhido)
+    {
+        switch (motor)
+        {
+        case Motor::DLX:
+            dlx = std::make_unique<SolucaoDLX>();
+            break;
+        case Motor::Simd:
+            vetorizado = std::make_unique<SolucaoSimd>();
+            break;
+        case Motor::Paralelo:
+            paralela = std::make_unique<SolucaoParalela>(threads_paralelo);
+            break;
+        case Motor::Intercalado:
+            intercalada = std::make_unique<SolucaoIntercalada>();
+            break;
+        default:
+            motor = Motor::Propagacao;
+            solucao = std::make_unique<Solucao<>>();
+            break;
+        }
+    }
+
+    // Mesma interface de Solucao::resolverSudoku, sem imprimir os passos
+    bool resolverSudoku(Tabuleiro &tabuleiro)
+    {
+        switch (motor)
+        {
+        case Motor::DLX:
+            return dlx->resolverSudoku(tabuleiro);
+        case Motor::Simd:
+            return vetorizado->resolverSudoku(tabuleiro);
+        case Motor::Paralelo:
+            return paralela->resolverSudoku(tabuleiro);
+        case Motor::Intercalado:
+            return intercalada->resolverSudoku(tabuleiro);
+        default:
+            return solucao->resolverSudoku(tabuleiro);
+        }
+    }
+
+    // Resolve n tabuleiros já validados; resolvidos[i] diz se o i-ésimo tem solução. Só o motor
+    // intercalado resolve vários ao mesmo tempo; os outros resolvem um por vez.
+    void resolverVarios(Tabuleiro *tabuleiros, bool *resolvidos, std::size_t n)
+    {
+        if (motor == Motor::Intercalado)
+        {
+            intercalada->resolverVarios(tabuleiros, resolvidos, n);
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+            resolvidos[i] = resolverSudoku(tabuleiros[i]);
+    }
+
+    // Mesma interface de Solucao::validarTabuleiro (sem estatísticas)
+    std::string validarTabuleiro(const Tabuleiro &tabuleiro) const
+    {
+        return validar_tabuleiro(tabuleiro);
+    }
+
+private:
+    Motor motor;
+    // Só o do motor escolhido deixa de ser nulo
+    std::unique_ptr<Solucao<>> solucao;
+    std::unique_ptr<SolucaoDLX> dlx;
+    std::unique_ptr<SolucaoSimd> vetorizado;
+    std::unique_ptr<SolucaoParalela> paralela;
+    std::unique_ptr<SolucaoIntercalada> intercalada;
+};
@@ -0,0 +1,163 @@
+// Rastreio.hpp
+
+#pragma once
+
+#include <vector>   // Para guardar os passos do rastreio binário
+#include <cstdint>  // Para std::uint16_t
+#include <iostream> // Para o rastreio em texto
+#include <fstream>  // Para salvar e ler o registro binário
+#include <string>   // Para nomes de arquivos
+
+#include "Tabuleiro.hpp" // Tabuleiro plano com as máscaras de linha, coluna e região
+
+// Políticas de rastreio do solucionador. Cada uma recebe três eventos:
+//   colocar:    um dígito (índice 0..8) foi colocado na célula
+//   retroceder: o chute feito na célula não levou a uma solução
+//   remover:    a célula foi esvaziada ao desfazer jogadas
+// A política é um parâmetro de template de Solucao, então a versão nula some na compilação.
+
+// Não registra nada: todas as chamadas são vazias e o compilador as elimina
+struct RastreioNulo
+{
+    void colocar(const Tabuleiro &, std::size_t, std::size_t, std::size_t) noexcept {}
+    void retroceder(const Tabuleiro &, std::size_t, std::size_t) noexcept {}
+    void remover(const Tabuleiro &, std::size_t, std::size_t) noexcept {}
+};
+
+// Mostra cada passo no terminal, como o SudokuResolver sempre fez
+struct RastreioTexto
+{
+    void colocar(const Tabuleiro &tabuleiro, std::size_t linha, std::size_t coluna, std::size_t idx_digito)
+    {
+        std::cout << "\nColocando " << (char)(idx_digito + '1') << " em (" << linha << ", " << coluna << ")\n";
+        imprimir_tabuleiro(tabuleiro);
+    }
+
+    void retroceder(const Tabuleiro &tabuleiro, std::size_t linha, std::size_t coluna)
+    {
+        std::cout << "\nRetrocedendo em (" << linha << ", " << coluna << ")\n";
+        imprimir_tabuleiro(tabuleiro);
+    }
+
+    void remover(const Tabuleiro &, std::size_t, std::size_t) noexcept {}
+};
+
+// Só conta os eventos: serve para medir o tamanho da busca (nós) sem guardar os passos
+struct RastreioContagem
+{
+    std::size_t colocacoes = 0; // Dígitos colocados, pela propagação ou por chute (nós da busca)
+    std::size_t retrocessos = 0; // Chutes que não levaram a uma solução
+
+    void colocar(const Tabuleiro &, std::size_t, std::size_t, std::size_t) noexcept
+    {
+        ++colocacoes;
+    }
+
+    void retroceder(const Tabuleiro &, std::size_t, std::size_t) noexcept
+    {
+        ++retrocessos;
+    }
+
+    void remover(const Tabuleiro &, std::size_t, std::size_t) noexcept {}
+};
+
+// Guarda cada passo em 2 bytes para ser reproduzido depois:
+// bits 0..3 = dígito, bits 4..10 = célula (0..80), bits 14..15 = tipo do evento
+class RastreioBinario
+{
+public:
+    enum Tipo : std::uint16_t
+    {
+        Colocar = 0,
+        Retroceder = 1,
+        Remover = 2,
+    };
+
+    void colocar(const Tabuleiro &, std::size_t linha, std::size_t coluna, std::size_t idx_digito)
+    {
+        registro.push_back(codificar(Colocar, linha * 9 + coluna, idx_digito));
+    }
+
+    void retroceder(const Tabuleiro &, std::size_t linha, std::size_t coluna)
+    {
+        registro.push_back(codificar(Retroceder, linha * 9 + coluna, 0));
+    }
+
+    void remover(const Tabuleiro &, std::size_t linha, std::size_t coluna)
+    {
+        registro.push_back(codificar(Remover, linha * 9 + coluna, 0));
+    }
+
+    // Passos registrados até agora
+    const std::vector<std::uint16_t> &passos() const noexcept
+    {
+        return registro;
+    }
+
+    std::vector<std::uint16_t> &passos() noexcept
+    {
+        return registro;
+    }
+
+    // Reproduz os passos a partir do tabuleiro inicial, repassando cada evento para outra política
+    template <class Destino>
+    static void reproduzir(const std::vector<std::uint16_t> &passos, Tabuleiro tabuleiro, Destino &destino)
+    {
+        for (std::uint16_t passo : passos)
+        {
+            std::size_t celula = (passo >> 4) & 0x7F;
+            std::size_t linha = celula / 9, coluna = celula % 9;
+            switch (passo >> 14)
+            {
+            case Colocar:
+                tabuleiro.colocar(linha, coluna, passo & 0xF);
+                destino.colocar(tabuleiro, linha, coluna, passo & 0xF);
+                break;
+            case Retroceder:
+                destino.retroceder(tabuleiro, linha, coluna);
+                break;
+            default:
+                tabuleiro.remover(linha, coluna, static_cast<std::size_t>(tabuleiro(linha, coluna) - '1'));
+                destino.remover(tabuleiro, linha, coluna);
+                break;
+            }
+        }
+    }
+
+private:
+    std::vector<std::uint16_t> registro;
+
+    static std::uint16_t codificar(Tipo tipo, std::size_t celula, std::size_t idx_digito) noexcept
+    {
+        return static_cast<std::uint16_t>((tipo << 14) | (celula << 4) | idx_digito);
+    }
+};
+
+// Salva o registro binário: as 81 células do tabuleiro inicial seguidas dos passos (2 bytes cada, little-endian)
+inline bool salvar_passos(const std::string &nome_arquivo, const Tabuleiro &inicial, const std::vector<std::uint16_t> &passos)
+{
+    std::ofstream arquivo(nome_arquivo, std::ios::binary);
+    if (!arquivo.is_open())
+        return false;
+    arquivo.write(inicial.celulas.data(), 81);
+    for (std::uint16_t passo : passos)
+    {
+        char bytes[2] = {static_cast<char>(passo & 0xFF), static_cast<char>(passo >> 8)};
+        arquivo.write(bytes, 2);
+    }
+    return static_cast<bool>(arquivo);
+}
+
+// Lê um registro salvo por salvar_passos
+inline bool carregar_passos(const std::string &nome_arquivo, Tabuleiro &inicial, std::vector<std::uint16_t> &passos)
+{
+    std::ifstream arquivo(nome_arquivo, std::ios::binary);
+    if (!arquivo.read(inicial.celulas.data(), 81))
+        return false;
+    inicial.recalcular_mascaras();
+    passos.clear();
+    unsigned char bytes[2];
+    while (arquivo.read(reinterpret_cast<char *>(bytes), 2))
+        passos.push_back(static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8)));
+    return true;
+}
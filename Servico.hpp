@@ -0,0 +1,425 @@
+// Servico.hpp
+
+#pragma once
+
+#include <algorithm>   // Para ordenar as latências do cliente
+#include <atomic>      // Para os instantes de envio lidos pela thread que recebe
+#include <chrono>      // Para medir o tempo de cada pedido
+#include <condition_variable> // Para o cliente esperar respostas quando limita os pedidos em voo
+#include <cstdint>     // Para std::uint64_t
+#include <cstdio>      // Para formatar os tempos (snprintf)
+#include <cstdlib>     // Para converter o id das respostas (strtoull)
+#include <functional>  // Para o destino das respostas de cada canal
+#include <iostream>    // Para o serviço pela entrada/saída padrão
+#include <memory>      // Para o canal compartilhado entre os pedidos de uma conexão
+#include <mutex>       // Para não misturar respostas no mesmo canal
+#include <string>      // Para os pedidos e as respostas
+#include <string_view> // Para as linhas recebidas
+#include <thread>      // Para as threads de trabalho e de cada conexão
+#include <vector>      // Para as threads e as latências
+
+#include "ExecutorParalelo.hpp" // Fila limitada e threads disponíveis
+#include "Carregador.hpp"       // Leitura dos quebra-cabeças do cliente
+#include "Solucao.hpp"          // Estado da busca dos pedidos atendidos em fatias
+
+#if !defined(_WIN32)
+#include <cerrno>       // Para repetir chamadas interrompidas (EINTR)
+#include <sys/socket.h> // Para socket/bind/listen/accept/send/recv
+#include <sys/un.h>     // Para sockaddr_un (socket local)
+#include <unistd.h>     // Para close/unlink
+#endif
+
+// Serviço de resolução de longa duração: os quebra-cabeças chegam pela entrada padrão ou por um socket
+// local (Unix), passam por uma fila limitada e são resolvidos por um grupo fixo de threads, cada uma com
+// o seu solucionador já aquecido. Assim cada pedido não paga a criação do processo, o locale e os prompts.
+//
+// Protocolo (uma linha por pedido; o cliente pode mandar vários sem esperar as respostas):
+//   pedido:   [id] tabuleiro   (sem id, os pedidos de cada conexão são numerados a partir de 1)
+//   resposta: id us_resolucao us_total resultado
+// O resultado é a mesma linha do modo em lote (a solução ou "tabuleiro ; motivo"). us_total conta desde
+// a leitura do pedido, incluindo a espera na fila. As respostas saem na ordem em que ficam prontas.
+// Com fatias de tempo, um pedido que não termina na sua fatia volta para o final da fila com o estado da
+// busca e é retomado depois, então um quebra-cabeça caro não segura uma thread enquanto os outros esperam;
+// us_resolucao soma todas as fatias.
+// Linhas vazias ou começando com '#' são ignoradas.
+
+// Destino das respostas de uma origem de pedidos (a saída padrão ou uma conexão). As threads de trabalho
+// respondem em paralelo, então cada resposta é escrita inteira sob a trava. Quando o último pedido da
+// conexão termina, o canal é destruído e chama ao_fechar (por exemplo, para fechar o socket).
+class CanalResposta
+{
+public:
+    explicit CanalResposta(DestinoTexto destino_respostas, std::function<void()> ao_fechar_canal = {})
+        : destino(std::move(destino_respostas)), ao_fechar(std::move(ao_fechar_canal))
+    {
+    }
+
+    CanalResposta(const CanalResposta &) = delete;
+    CanalResposta &operator=(const CanalResposta &) = delete;
+
+    ~CanalResposta()
+    {
+        if (ao_fechar)
+            ao_fechar();
+    }
+
+    void responder(const std::string &texto)
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        destino(texto);
+    }
+
+private:
+    std::mutex trava;
+    DestinoTexto destino;
+    std::function<void()> ao_fechar;
+};
+
+struct Pedido
+{
+    std::string id;
+    std::string tabuleiro;
+    std::shared_ptr<CanalResposta> canal;
+    std::chrono::steady_clock::time_point chegada;
+    std::unique_ptr<EstadoBusca> estado;             // Busca em andamento, entre uma fatia e outra
+    std::chrono::steady_clock::duration resolucao{}; // Tempo de todas as fatias já atendidas
+};
+
+// Fila limitada + grupo de threads. Resolver é chamado como resolver(id_thread, pedido, resultado) e
+// acrescenta em resultado a linha de saída (terminada em '\n'), retornando true; retorna false se o
+// pedido ficou para outra fatia (sem escrever nada). Cada id_thread só é usado por uma thread.
+template <class Resolver>
+class Servico
+{
+public:
+    Servico(unsigned num_threads, std::size_t capacidade_fila, Resolver resolver_usado)
+        : fila(capacidade_fila), resolver(std::move(resolver_usado))
+    {
+        for (unsigned t = 0; t < std::max(1u, num_threads); ++t)
+            trabalhadores.emplace_back([this, t]
+                                       { atender(t); });
+    }
+
+    ~Servico()
+    {
+        encerrar();
+    }
+
+    // Interpreta uma linha de pedido e coloca na fila (espera se ela estiver cheia).
+    // proximo_id numera os pedidos sem id da mesma origem.
+    void receber(std::string_view linha, const std::shared_ptr<CanalResposta> &canal, std::uint64_t &proximo_id)
+    {
+        if (!linha.empty() && linha.back() == '\r')
+            linha.remove_suffix(1);
+        if (linha.empty() || linha[0] == '#')
+            return;
+
+        Pedido pedido;
+        pedido.chegada = std::chrono::steady_clock::now();
+        std::size_t espaco = linha.find(' ');
+        if (espaco == std::string_view::npos)
+        {
+            pedido.id = std::to_string(proximo_id++);
+            pedido.tabuleiro = linha;
+        }
+        else
+        {
+            pedido.id = linha.substr(0, espaco);
+            pedido.tabuleiro = linha.substr(espaco + 1);
+        }
+        pedido.canal = canal;
+        fila.colocar(std::move(pedido));
+    }
+
+    // Para de aceitar pedidos, responde os que estão na fila e espera as threads terminarem
+    void encerrar()
+    {
+        fila.fechar();
+        for (std::thread &trabalhador : trabalhadores)
+            if (trabalhador.joinable())
+                trabalhador.join();
+    }
+
+private:
+    FilaLimitada<Pedido> fila;
+    Resolver resolver;
+    std::vector<std::thread> trabalhadores;
+
+    void atender(unsigned id)
+    {
+        Pedido pedido;
+        std::string resultado;
+        std::string resposta;
+        while (fila.tirar(pedido))
+        {
+            auto inicio = std::chrono::steady_clock::now();
+            resultado.clear();
+            bool terminou = resolver(id, pedido, resultado);
+            auto fim = std::chrono::steady_clock::now();
+            pedido.resolucao += fim - inicio;
+            if (!terminou)
+            {
+                fila.devolver(std::move(pedido));
+                continue;
+            }
+
+            char tempos[64];
+            std::snprintf(tempos, sizeof(tempos), " %.1f %.1f ",
+                          std::chrono::duration<double, std::micro>(pedido.resolucao).count(),
+                          std::chrono::duration<double, std::micro>(fim - pedido.chegada).count());
+            resposta = pedido.id;
+            resposta += tempos;
+            resposta += resultado;
+            pedido.canal->responder(resposta);
+            pedido.canal.reset(); // A conexão pode fechar assim que a sua última resposta sair
+        }
+    }
+};
+
+// Atende os pedidos da entrada padrão até ela acabar e responde na saída padrão
+template <class Resolver>
+int servir_entrada_padrao(Servico<Resolver> &servico)
+{
+    auto canal = std::make_shared<CanalResposta>([](const std::string &texto)
+                                                 {
+        std::cout.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+        std::cout.flush(); });
+    // cin presa ao cout faria a thread que lê esvaziar o cout junto com as threads que respondem
+    std::cin.tie(nullptr);
+    std::string linha;
+    std::uint64_t proximo_id = 1;
+    while (std::getline(std::cin, linha))
+        servico.receber(linha, canal, proximo_id);
+    servico.encerrar();
+    return 0;
+}
+
+#if !defined(_WIN32)
+
+// Envia o texto inteiro (send pode mandar só uma parte); retorna false se a conexão caiu
+inline bool enviar_tudo(int conexao, const char *dados, std::size_t tamanho)
+{
+#if defined(MSG_NOSIGNAL)
+    constexpr int OPCOES = MSG_NOSIGNAL; // Cliente que fechou não derruba o serviço com SIGPIPE
+#else
+    constexpr int OPCOES = 0;
+#endif
+    while (tamanho > 0)
+    {
+        ssize_t enviados = ::send(conexao, dados, tamanho, OPCOES);
+        if (enviados < 0 && errno == EINTR)
+            continue;
+        if (enviados <= 0)
+            return false;
+        dados += enviados;
+        tamanho -= static_cast<std::size_t>(enviados);
+    }
+    return true;
+}
+
+// Lê a conexão até o fim, entregando cada linha completa a receber_linha
+template <class Funcao>
+void ler_linhas(int conexao, Funcao receber_linha)
+{
+    std::string pendente;
+    char bloco[1 << 16];
+    for (;;)
+    {
+        ssize_t lidos = ::recv(conexao, bloco, sizeof(bloco), 0);
+        if (lidos < 0 && errno == EINTR)
+            continue;
+        if (lidos <= 0)
+            break;
+        pendente.append(bloco, static_cast<std::size_t>(lidos));
+        std::size_t inicio = 0;
+        std::size_t quebra;
+        while ((quebra = pendente.find('\n', inicio)) != std::string::npos)
+        {
+            receber_linha(std::string_view(pendente.data() + inicio, quebra - inicio));
+            inicio = quebra + 1;
+        }
+        pendente.erase(0, inicio);
+    }
+    // Última linha sem '\n'
+    if (!pendente.empty())
+        receber_linha(std::string_view(pendente));
+}
+
+// Prepara o endereço do socket local; retorna false se o caminho não couber
+inline bool endereco_local(const std::string &caminho, sockaddr_un &endereco)
+{
+    endereco = sockaddr_un{};
+    endereco.sun_family = AF_UNIX;
+    if (caminho.empty() || caminho.size() >= sizeof(endereco.sun_path))
+    {
+        std::cerr << "Caminho inválido para o socket: " << caminho << "\n";
+        return false;
+    }
+    caminho.copy(endereco.sun_path, caminho.size());
+    return true;
+}
+
+#endif
+
+// Atende conexões no socket local até o processo ser encerrado; cada conexão tem uma thread que lê
+// os pedidos, e todas compartilham a fila e as threads de trabalho
+template <class Resolver>
+int servir_socket(Servico<Resolver> &servico, const std::string &caminho)
+{
+#if defined(_WIN32)
+    (void)servico;
+    (void)caminho;
+    std::cerr << "O socket local não é suportado no Windows; use --servico pela entrada padrão\n";
+    return 1;
+#else
+    sockaddr_un endereco;
+    if (!endereco_local(caminho, endereco))
+        return 1;
+    int servidor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0)
+    {
+        std::cerr << "Não foi possível criar o socket\n";
+        return 1;
+    }
+    ::unlink(caminho.c_str()); // Remove o socket deixado por uma execução anterior
+    if (::bind(servidor, reinterpret_cast<const sockaddr *>(&endereco), sizeof(endereco)) != 0 ||
+        ::listen(servidor, 64) != 0)
+    {
+        std::cerr << "Não foi possível atender em: " << caminho << "\n";
+        ::close(servidor);
+        return 1;
+    }
+    std::cerr << "Atendendo em " << caminho << std::endl;
+
+    for (;;)
+    {
+        int conexao = ::accept(servidor, nullptr, nullptr);
+        if (conexao < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        std::thread([&servico, conexao]
+                    {
+            // O socket fecha quando a última resposta da conexão sair
+            auto canal = std::make_shared<CanalResposta>(
+                [conexao](const std::string &texto)
+                { enviar_tudo(conexao, texto.data(), texto.size()); },
+                [conexao]
+                { ::close(conexao); });
+            std::uint64_t proximo_id = 1;
+            ler_linhas(conexao, [&](std::string_view linha)
+                       { servico.receber(linha, canal, proximo_id); }); })
+            .detach();
+    }
+    ::close(servidor);
+    std::cerr << "O socket parou de aceitar conexões: " << caminho << "\n";
+    return 1;
+#endif
+}
+
+// Cliente de teste: manda os quebra-cabeças do arquivo pelo socket (ids 1, 2, 3, ...) sem esperar as
+// respostas, com no máximo em_voo pedidos sem resposta (0 = sem limite; 1 mede a latência de um pedido
+// sozinho). Escreve as respostas na saída padrão e mostra no stderr a vazão e a latência de ponta a ponta
+// de cada pedido (do envio até a resposta).
+inline int executar_cliente(const std::string &caminho_socket, const std::string &caminho_entrada, std::size_t em_voo)
+{
+#if defined(_WIN32)
+    (void)caminho_socket;
+    (void)caminho_entrada;
+    (void)em_voo;
+    std::cerr << "O socket local não é suportado no Windows\n";
+    return 1;
+#else
+    EntradaQuebraCabecas entrada;
+    if (!entrada.abrir(caminho_entrada))
+    {
+        std::cerr << "Não foi possível abrir o arquivo: " << caminho_entrada << "\n";
+        return 1;
+    }
+    const std::vector<std::string_view> &linhas = entrada.linhas();
+
+    sockaddr_un endereco;
+    if (!endereco_local(caminho_socket, endereco))
+        return 1;
+    int conexao = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (conexao < 0 || ::connect(conexao, reinterpret_cast<const sockaddr *>(&endereco), sizeof(endereco)) != 0)
+    {
+        std::cerr << "Não foi possível conectar em: " << caminho_socket << "\n";
+        if (conexao >= 0)
+            ::close(conexao);
+        return 1;
+    }
+
+    using Relogio = std::chrono::steady_clock;
+    Relogio::time_point inicio = Relogio::now();
+    std::vector<std::atomic<long long>> envio(linhas.size()); // Nanossegundos desde o início
+    std::size_t respondidos = 0;
+    bool caiu = false;
+    std::mutex trava;
+    std::condition_variable chegou_resposta;
+    std::thread remetente([&]
+                          {
+        std::string pedido;
+        for (std::size_t i = 0; i < linhas.size(); ++i)
+        {
+            if (em_voo > 0)
+            {
+                std::unique_lock<std::mutex> guarda(trava);
+                chegou_resposta.wait(guarda, [&]
+                                     { return caiu || i - respondidos < em_voo; });
+                if (caiu)
+                    break;
+            }
+            pedido = std::to_string(i + 1);
+            pedido += ' ';
+            pedido += linhas[i];
+            pedido += '\n';
+            envio[i].store(std::chrono::duration_cast<std::chrono::nanoseconds>(Relogio::now() - inicio).count(),
+                           std::memory_order_relaxed);
+            if (!enviar_tudo(conexao, pedido.data(), pedido.size()))
+                break;
+        }
+        // Avisa o serviço que não há mais pedidos
+        ::shutdown(conexao, SHUT_WR); });
+
+    std::vector<double> latencias;
+    latencias.reserve(linhas.size());
+    ler_linhas(conexao, [&](std::string_view resposta)
+               {
+        double agora = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+        unsigned long long id = std::strtoull(std::string(resposta.substr(0, resposta.find(' '))).c_str(), nullptr, 10);
+        if (id >= 1 && id <= linhas.size())
+            latencias.push_back((agora - static_cast<double>(envio[id - 1].load(std::memory_order_relaxed))) / 1000.0);
+        std::cout.write(resposta.data(), static_cast<std::streamsize>(resposta.size()));
+        std::cout.put('\n');
+        {
+            std::lock_guard<std::mutex> guarda(trava);
+            ++respondidos;
+        }
+        chegou_resposta.notify_one(); });
+    {
+        // Conexão encerrada: o remetente não pode ficar esperando respostas que não vêm mais
+        std::lock_guard<std::mutex> guarda(trava);
+        caiu = true;
+    }
+    chegou_resposta.notify_one();
+    double segundos = std::chrono::duration<double>(Relogio::now() - inicio).count();
+    remetente.join();
+    ::close(conexao);
+    std::cout.flush();
+
+    std::sort(latencias.begin(), latencias.end());
+    auto percentil = [&](double p)
+    {
+        return latencias.empty() ? 0.0 : latencias[std::min(latencias.size() - 1, static_cast<std::size_t>(p * static_cast<double>(latencias.size())))];
+    };
+    std::cerr << "Pedidos: " << linhas.size() << " | Respostas: " << latencias.size()
+              << " | Tempo total: " << segundos * 1000.0 << " ms"
+              << " | Pedidos/s: " << (segundos > 0 ? static_cast<double>(latencias.size()) / segundos : 0.0)
+              << " | Latência p50: " << percentil(0.50) << " us | p99: " << percentil(0.99)
+              << " us | máx: " << (latencias.empty() ? 0.0 : latencias.back()) << " us" << std::endl;
+    return latencias.size() == linhas.size() ? 0 : 1;
+#endif
+}
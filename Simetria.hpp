@@ -0,0 +1,319 @@
+// Simetria.hpp
+
+#pragma once
+
+#include <algorithm> // Para std::min e std::swap
+#include <array>     // Para as permutações e os rótulos de tamanho fixo
+#include <cstdint>   // Para std::uint8_t e std::uint64_t
+#include <vector>    // Para a fronteira da busca pela forma canônica
+
+#include "Tabuleiro.hpp" // Tabuleiro plano de 81 células com máscaras
+
+// Forma canônica de um quebra-cabeça 9x9 pelas simetrias do Sudoku: transposição, troca das bandas
+// (grupos de 3 linhas) e das pilhas (grupos de 3 colunas), troca de linhas dentro da banda e de colunas
+// dentro da pilha, e troca dos dígitos. Dois quebra-cabeças iguais a menos dessas simetrias têm a
+// mesma forma canônica: a menor, em ordem lexicográfica (vazio antes de qualquer dígito), entre todas
+// as transformações, com os dígitos renomeados 1, 2, 3, ... na ordem em que aparecem.
+
+// As 6 ordens de 3 elementos (de pilhas dentro do tabuleiro ou de colunas dentro da pilha)
+constexpr std::uint8_t ORDENS_TRIO[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// As 1296 permutações de colunas que respeitam as pilhas (6 ordens das pilhas x 6^3 ordens dentro delas).
+// O índice é pilhas * 216 + dentro[0] * 36 + dentro[1] * 6 + dentro[2], com dentro[p] a ordem das colunas
+// da pilha que ficou na posição p.
+constexpr std::size_t NUM_PERMUTACOES_COLUNAS = 1296;
+
+constexpr std::array<std::array<std::uint8_t, 9>, NUM_PERMUTACOES_COLUNAS> gerar_permutacoes_colunas() noexcept
+{
+    std::array<std::array<std::uint8_t, 9>, NUM_PERMUTACOES_COLUNAS> permutacoes{};
+    std::size_t n = 0;
+    for (std::size_t pilhas = 0; pilhas < 6; ++pilhas)
+        for (std::size_t a = 0; a < 6; ++a)
+            for (std::size_t b = 0; b < 6; ++b)
+                for (std::size_t c = 0; c < 6; ++c)
+                {
+                    const std::size_t dentro[3] = {a, b, c};
+                    for (std::size_t p = 0; p < 3; ++p)
+                        for (std::size_t k = 0; k < 3; ++k)
+                            permutacoes[n][p * 3 + k] =
+                                static_cast<std::uint8_t>(ORDENS_TRIO[pilhas][p] * 3 + ORDENS_TRIO[dentro[p]][k]);
+                    ++n;
+                }
+    return permutacoes;
+}
+
+constexpr std::array<std::array<std::uint8_t, 9>, NUM_PERMUTACOES_COLUNAS> PERMUTACOES_COLUNAS = gerar_permutacoes_colunas();
+
+// Transformação que leva um tabuleiro à sua forma canônica:
+// célula canônica (i, j) = célula (linha_origem[i], coluna_origem[j]) do original (transposto se for o caso),
+// com o dígito d trocado por rotulo[d]
+struct Transformacao
+{
+    bool transposto = false;
+    std::array<std::uint8_t, 9> linha_origem{};
+    std::array<std::uint8_t, 9> coluna_origem{};
+    std::array<std::uint8_t, 10> rotulo{}; // 0 = dígito ainda sem rótulo
+
+    // Dá rótulos aos dígitos que não aparecem no quebra-cabeça (em ordem crescente), para poder
+    // transformar também a solução, que tem todos os dígitos
+    void completar() noexcept
+    {
+        std::uint16_t usados = 0;
+        for (std::size_t d = 1; d <= 9; ++d)
+            if (rotulo[d])
+                usados |= static_cast<std::uint16_t>(1u << rotulo[d]);
+        std::uint8_t proximo = 1;
+        for (std::size_t d = 1; d <= 9; ++d)
+        {
+            if (rotulo[d])
+                continue;
+            while (usados & (1u << proximo))
+                ++proximo;
+            rotulo[d] = proximo++;
+        }
+    }
+
+    // Leva o tabuleiro original para a forma canônica (a transformação precisa estar completa
+    // se o tabuleiro tiver dígitos que não estavam no quebra-cabeça)
+    Tabuleiro aplicar(const Tabuleiro &original) const noexcept
+    {
+        Tabuleiro resultado;
+        for (std::size_t i = 0; i < 9; ++i)
+        {
+            for (std::size_t j = 0; j < 9; ++j)
+            {
+                char c = transposto ? original(coluna_origem[j], linha_origem[i]) : original(linha_origem[i], coluna_origem[j]);
+                resultado(i, j) = c == '.' ? '.' : static_cast<char>('0' + rotulo[static_cast<std::size_t>(c - '0')]);
+            }
+        }
+        resultado.recalcular_mascaras();
+        return resultado;
+    }
+
+    // Volta da forma canônica para o original (a transformação precisa estar completa)
+    Tabuleiro desfazer(const Tabuleiro &canonico) const noexcept
+    {
+        std::array<char, 10> digito_do_rotulo{};
+        for (std::size_t d = 1; d <= 9; ++d)
+            digito_do_rotulo[rotulo[d]] = static_cast<char>('0' + d);
+        Tabuleiro resultado;
+        for (std::size_t i = 0; i < 9; ++i)
+        {
+            for (std::size_t j = 0; j < 9; ++j)
+            {
+                char c = canonico(i, j);
+                char &destino = transposto ? resultado(coluna_origem[j], linha_origem[i]) : resultado(linha_origem[i], coluna_origem[j]);
+                destino = c == '.' ? '.' : digito_do_rotulo[static_cast<std::size_t>(c - '0')];
+            }
+        }
+        resultado.recalcular_mascaras();
+        return resultado;
+    }
+};
+
+// Calcula a forma canônica linha por linha. A fronteira guarda todas as transformações parciais
+// (transposição, linhas já escolhidas, permutação de colunas e rótulos) cujo prefixo é o menor possível;
+// a cada linha só continuam as que empatam no menor valor dela. A primeira linha só depende de quais
+// células têm pista (os rótulos dela são sempre 1, 2, 3...), então as 1296 permutações de colunas só são
+// testadas nas linhas que podem dar o menor padrão. Reaproveite o objeto para não alocar a cada chamada.
+// Tabuleiros quase vazios têm simetrias demais e a fronteira explodiria: acima de LIMITE_FRONTEIRA
+// estados a canonização desiste e quem chamou resolve o quebra-cabeça direto.
+class Canonizador
+{
+public:
+    static constexpr std::size_t LIMITE_FRONTEIRA = 1 << 15;
+
+    // Calcula a forma canônica do tabuleiro (só '.' e '1'..'9', já validado) e a transformação usada;
+    // retorna false se o tabuleiro tiver simetrias demais
+    bool canonizar(const Tabuleiro &tabuleiro, Tabuleiro &canonico, Transformacao &transformacao)
+    {
+        // Valores 0..9 das duas orientações: normal e transposta
+        for (std::size_t i = 0; i < 9; ++i)
+        {
+            for (std::size_t j = 0; j < 9; ++j)
+            {
+                char c = tabuleiro(i, j);
+                std::uint8_t valor = c == '.' ? 0 : static_cast<std::uint8_t>(c - '0');
+                grade[0][i * 9 + j] = valor;
+                grade[1][j * 9 + i] = valor;
+            }
+        }
+
+        iniciar_fronteira();
+        for (std::size_t passo = 1; passo < 9; ++passo)
+            if (!avancar())
+                return false;
+
+        // Todos os estados que sobraram dão a mesma forma; qualquer um serve
+        const Estado &escolhido = fronteira.front();
+        transformacao.transposto = escolhido.transposto != 0;
+        transformacao.linha_origem = escolhido.linhas;
+        transformacao.coluna_origem = PERMUTACOES_COLUNAS[escolhido.permutacao];
+        transformacao.rotulo = escolhido.rotulo;
+        canonico = transformacao.aplicar(tabuleiro);
+        return true;
+    }
+
+private:
+    // Uma transformação parcial: as primeiras 'quantidade' linhas já estão escolhidas
+    struct Estado
+    {
+        std::uint16_t permutacao;
+        std::uint8_t transposto;
+        std::uint8_t quantidade;
+        std::uint16_t linhas_usadas;
+        std::uint8_t proximo_rotulo;
+        std::array<std::uint8_t, 9> linhas;
+        std::array<std::uint8_t, 10> rotulo;
+    };
+
+    std::array<std::array<std::uint8_t, 81>, 2> grade;
+    std::vector<Estado> fronteira;
+    std::vector<Estado> proxima;
+
+    // Padrão de pistas da linha com a melhor ordem de colunas: pilhas com menos pistas primeiro e,
+    // dentro de cada pilha, as vazias primeiro. Lido como número binário, o menor é o melhor.
+    std::uint32_t menor_padrao(const std::uint8_t *linha) const noexcept
+    {
+        std::array<std::uint8_t, 3> pistas{};
+        for (std::size_t c = 0; c < 9; ++c)
+            pistas[c / 3] += linha[c] != 0;
+        // Ordena as 3 contagens (crescente)
+        if (pistas[0] > pistas[1])
+            std::swap(pistas[0], pistas[1]);
+        if (pistas[1] > pistas[2])
+            std::swap(pistas[1], pistas[2]);
+        if (pistas[0] > pistas[1])
+            std::swap(pistas[0], pistas[1]);
+        std::uint32_t padrao = 0;
+        for (std::uint8_t p : pistas)
+            padrao = (padrao << 3) | ((1u << p) - 1);
+        return padrao;
+    }
+
+    // Primeira linha: escolhe as linhas com o menor padrão e gera direto as permutações de colunas que
+    // o alcançam (pilhas em ordem crescente de pistas, vazias antes das pistas dentro de cada pilha)
+    void iniciar_fronteira()
+    {
+        std::uint32_t melhor = ~0u;
+        for (std::uint8_t t = 0; t < 2; ++t)
+            for (std::size_t r = 0; r < 9; ++r)
+                melhor = std::min(melhor, menor_padrao(&grade[t][r * 9]));
+
+        fronteira.clear();
+        for (std::uint8_t t = 0; t < 2; ++t)
+        {
+            for (std::size_t r = 0; r < 9; ++r)
+            {
+                const std::uint8_t *linha = &grade[t][r * 9];
+                if (menor_padrao(linha) != melhor)
+                    continue;
+
+                // Ordens válidas dentro de cada pilha e quantidade de pistas nela
+                std::array<std::array<std::uint8_t, 6>, 3> dentro{};
+                std::array<std::uint8_t, 3> num_dentro{};
+                std::array<std::uint8_t, 3> pistas{};
+                for (std::size_t pilha = 0; pilha < 3; ++pilha)
+                {
+                    for (std::size_t k = 0; k < 3; ++k)
+                        pistas[pilha] += linha[pilha * 3 + k] != 0;
+                    std::size_t vazias = 3 - pistas[pilha];
+                    for (std::uint8_t ordem = 0; ordem < 6; ++ordem)
+                    {
+                        bool valida = true;
+                        for (std::size_t k = 0; k < vazias; ++k)
+                            valida &= linha[pilha * 3 + ORDENS_TRIO[ordem][k]] == 0;
+                        if (valida)
+                            dentro[pilha][num_dentro[pilha]++] = ordem;
+                    }
+                }
+
+                for (std::size_t pilhas = 0; pilhas < 6; ++pilhas)
+                {
+                    const std::uint8_t *ordem = ORDENS_TRIO[pilhas];
+                    if (pistas[ordem[0]] > pistas[ordem[1]] || pistas[ordem[1]] > pistas[ordem[2]])
+                        continue;
+                    for (std::size_t a = 0; a < num_dentro[ordem[0]]; ++a)
+                        for (std::size_t b = 0; b < num_dentro[ordem[1]]; ++b)
+                            for (std::size_t c = 0; c < num_dentro[ordem[2]]; ++c)
+                                adicionar_inicio(t, r, pilhas * 216 + dentro[ordem[0]][a] * 36u +
+                                                           dentro[ordem[1]][b] * 6u + dentro[ordem[2]][c]);
+                }
+            }
+        }
+    }
+
+    void adicionar_inicio(std::uint8_t t, std::size_t r, std::size_t p)
+    {
+        const std::uint8_t *linha = &grade[t][r * 9];
+        Estado estado{};
+        estado.permutacao = static_cast<std::uint16_t>(p);
+        estado.transposto = t;
+        estado.quantidade = 1;
+        estado.linhas_usadas = static_cast<std::uint16_t>(1u << r);
+        estado.linhas[0] = static_cast<std::uint8_t>(r);
+        estado.proximo_rotulo = 1;
+        // Rótulos na ordem em que os dígitos aparecem na linha
+        for (std::size_t c = 0; c < 9; ++c)
+        {
+            std::uint8_t valor = linha[PERMUTACOES_COLUNAS[p][c]];
+            if (valor)
+                estado.rotulo[valor] = estado.proximo_rotulo++;
+        }
+        fronteira.push_back(estado);
+    }
+
+    // Escolhe a próxima linha de cada estado e mantém só os que dão o menor valor para ela.
+    // A próxima linha é uma das que faltam na banda atual ou, com a banda completa, qualquer linha de outra banda.
+    // Retorna false se a fronteira passar do limite.
+    bool avancar()
+    {
+        proxima.clear();
+        std::uint64_t melhor = ~std::uint64_t{0};
+        for (const Estado &estado : fronteira)
+        {
+            std::size_t ultima = estado.linhas[estado.quantidade - 1];
+            bool banda_completa = estado.quantidade % 3 == 0;
+            for (std::size_t r = 0; r < 9; ++r)
+            {
+                if (estado.linhas_usadas & (1u << r))
+                    continue;
+                if (!banda_completa && r / 3 != ultima / 3)
+                    continue;
+                if (banda_completa && (estado.linhas_usadas >> (r / 3 * 3) & 7u))
+                    continue;
+
+                // Valor da linha com os rótulos atuais (dígitos novos ganham os próximos rótulos)
+                const std::uint8_t *linha = &grade[estado.transposto][r * 9];
+                const std::array<std::uint8_t, 9> &colunas = PERMUTACOES_COLUNAS[estado.permutacao];
+                std::array<std::uint8_t, 10> rotulo = estado.rotulo;
+                std::uint8_t proximo_rotulo = estado.proximo_rotulo;
+                std::uint64_t valor = 0;
+                for (std::size_t c = 0; c < 9; ++c)
+                {
+                    std::uint8_t v = linha[colunas[c]];
+                    if (v && !rotulo[v])
+                        rotulo[v] = proximo_rotulo++;
+                    valor = (valor << 4) | (v ? rotulo[v] : 0u);
+                }
+                if (valor > melhor)
+                    continue;
+                if (valor < melhor)
+                {
+                    melhor = valor;
+                    proxima.clear();
+                }
+                Estado novo = estado;
+                novo.linhas[novo.quantidade++] = static_cast<std::uint8_t>(r);
+                novo.linhas_usadas = static_cast<std::uint16_t>(novo.linhas_usadas | (1u << r));
+                novo.rotulo = rotulo;
+                novo.proximo_rotulo = proximo_rotulo;
+                if (proxima.size() == LIMITE_FRONTEIRA)
+                    return false;
+                proxima.push_back(novo);
+            }
+        }
+        fronteira.swap(proxima);
+        return true;
+    }
+};
@@ -0,0 +1,662 @@
+// Solucao.hpp
+
+#pragma once
+
+#include <string>   // Para as mensagens de validação
+#include <array>    // Para a trilha de jogadas e as máscaras da validação
+#include <cstdint>  // Para std::uint8_t
+#include <atomic>   // Para o sinal de cancelamento da busca paralela
+#include <vector>   // Para as subárvores da divisão da busca
+#include <chrono>   // Para o orçamento de tempo da busca iterativa
+#include <limits>   // Para o orçamento sem limite
+
+#include "Tabuleiro.hpp" // Tabuleiro plano com as máscaras de linha, coluna e região
+#include "Rastreio.hpp"  // Políticas de rastreio dos passos
+#include "Estatisticas.hpp" // Políticas de contadores e tempos da busca
+
+// Mensagens de validar_tabuleiro e verificar_solucao (a unidade é 0..8 dentro do seu tipo)
+inline std::string repeticao_na_linha(std::size_t linha)
+{
+    return "Número repetido na linha " + std::to_string(linha + 1) + ".";
+}
+
+inline std::string repeticao_na_coluna(std::size_t coluna)
+{
+    return "Número repetido na coluna " + std::to_string(coluna + 1) + ".";
+}
+
+inline std::string repeticao_no_bloco(std::size_t regiao)
+{
+    return "Número repetido no bloco 3x3 começando em linha " + std::to_string(regiao / 3 * 3 + 1) +
+           ", coluna " + std::to_string(regiao % 3 * 3 + 1) + ".";
+}
+
+// Função que valida o tabuleiro antes de resolver (repetição ou caractere inválido).
+// Uma passada só pelas 81 células, marcando cada dígito nas máscaras da linha, coluna e região e
+// guardando num bit por unidade onde ele já estava; nenhuma alocação quando o tabuleiro é válido.
+// A prioridade das mensagens é a de sempre: a primeira linha com repetição, depois a primeira coluna,
+// o primeiro bloco e, por último, o primeiro caractere inválido na ordem de leitura.
+inline std::string validar_tabuleiro(const Tabuleiro &tabuleiro)
+{
+    std::array<Mascara, 9> linhas{}, colunas{}, regioes{};
+    std::uint32_t repetidas_linhas = 0, repetidas_colunas = 0, repetidas_regioes = 0;
+    std::array<std::uint8_t, 81> invalidas;
+    std::size_t num_invalidas = 0;
+    for (std::size_t celula = 0; celula < 81; ++celula)
+    {
+        char c = tabuleiro.celulas[celula];
+        if (c == '.')
+            continue;
+        unsigned idx = static_cast<unsigned>(static_cast<unsigned char>(c) - '1');
+        if (idx >= 9)
+        {
+            invalidas[num_invalidas++] = static_cast<std::uint8_t>(celula);
+            continue;
+        }
+        std::size_t linha = celula / 9, coluna = celula % 9, regiao = obter_regiao(linha, coluna);
+        Mascara bit = static_cast<Mascara>(1u << idx);
+        repetidas_linhas |= static_cast<std::uint32_t>((linhas[linha] & bit) != 0) << linha;
+        repetidas_colunas |= static_cast<std::uint32_t>((colunas[coluna] & bit) != 0) << coluna;
+        repetidas_regioes |= static_cast<std::uint32_t>((regioes[regiao] & bit) != 0) << regiao;
+        linhas[linha] |= bit;
+        colunas[coluna] |= bit;
+        regioes[regiao] |= bit;
+    }
+
+    // Um caractere inválido repetido na mesma unidade também conta como repetição (raro: só quando há inválidos)
+    for (std::size_t i = 0; i < num_invalidas; ++i)
+    {
+        for (std::size_t j = i + 1; j < num_invalidas; ++j)
+        {
+            std::size_t a = invalidas[i], b = invalidas[j];
+            if (tabuleiro.celulas[a] != tabuleiro.celulas[b])
+                continue;
+            if (a / 9 == b / 9)
+                repetidas_linhas |= 1u << (a / 9);
+            if (a % 9 == b % 9)
+                repetidas_colunas |= 1u << (a % 9);
+            if (obter_regiao(a / 9, a % 9) == obter_regiao(b / 9, b % 9))
+                repetidas_regioes |= 1u << obter_regiao(a / 9, a % 9);
+        }
+    }
+
+    if (repetidas_linhas)
+        return repeticao_na_linha(static_cast<std::size_t>(__builtin_ctz(repetidas_linhas)));
+    if (repetidas_colunas)
+        return repeticao_na_coluna(static_cast<std::size_t>(__builtin_ctz(repetidas_colunas)));
+    if (repetidas_regioes)
+        return repeticao_no_bloco(static_cast<std::size_t>(__builtin_ctz(repetidas_regioes)));
+    if (num_invalidas > 0)
+        return "Caractere inválido na posição linha " + std::to_string(invalidas[0] / 9 + 1) +
+               ", coluna " + std::to_string(invalidas[0] % 9 + 1) + ".";
+    return ""; // Retorna string vazia se não encontrar problema
+}
+
+// Confere se 'solucao' resolve 'quebra_cabeca': completa, sem repetição e com todas as pistas no lugar.
+// Retorna o motivo (na ordem: célula vazia ou inválida, pista trocada, repetição) ou vazio se está certa.
+// Como validar_tabuleiro, é uma passada só; as 27 máscaras de uma solução certa são todas TODOS_DIGITOS.
+inline std::string verificar_solucao(const Tabuleiro &quebra_cabeca, const Tabuleiro &solucao)
+{
+    std::array<Mascara, 27> unidades{};
+    for (std::size_t celula = 0; celula < 81; ++celula)
+    {
+        char c = solucao.celulas[celula];
+        unsigned idx = static_cast<unsigned>(static_cast<unsigned char>(c) - '1');
+        if (idx >= 9)
+            return "Célula vazia ou inválida na solução, linha " + std::to_string(celula / 9 + 1) +
+                   ", coluna " + std::to_string(celula % 9 + 1) + ".";
+        char pista = quebra_cabeca.celulas[celula];
+        if (pista != '.' && pista != c)
+            return "A solução troca a pista da linha " + std::to_string(celula / 9 + 1) +
+                   ", coluna " + std::to_string(celula % 9 + 1) + ".";
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        Mascara bit = static_cast<Mascara>(1u << idx);
+        unidades[linha] |= bit;
+        unidades[9 + coluna] |= bit;
+        unidades[18 + obter_regiao(linha, coluna)] |= bit;
+    }
+    // Com as 81 células preenchidas, uma unidade sem algum dígito tem obrigatoriamente outro repetido
+    for (std::size_t unidade = 0; unidade < 27; ++unidade)
+    {
+        if (unidades[unidade] == TODOS_DIGITOS)
+            continue;
+        if (unidade < 9)
+            return repeticao_na_linha(unidade);
+        if (unidade < 18)
+            return repeticao_na_coluna(unidade - 9);
+        return repeticao_no_bloco(unidade - 18);
+    }
+    return "";
+}
+
+// Onde a busca chuta: numa célula (uma alternativa por dígito candidato) ou num dígito de uma unidade
+// (uma alternativa por célula da unidade onde ele ainda cabe). As alternativas são disjuntas e uma delas
+// é verdadeira em qualquer solução, então tentar todas percorre cada solução exatamente uma vez.
+struct Ramo
+{
+    static constexpr std::uint8_t POR_CELULA = 27; // Valor de 'unidade' no ramo por célula
+
+    std::uint8_t unidade;    // Unidade do ramo por dígito, ou POR_CELULA
+    std::uint8_t fixo;       // A célula (ramo por célula) ou o dígito, índice 0..8 (ramo por unidade)
+    Mascara alternativas;    // Bit k: o dígito k na célula, ou a k-ésima célula da unidade
+
+    // Célula e dígito da alternativa k
+    void jogada(std::size_t k, std::size_t &celula, std::size_t &idx_digito) const noexcept
+    {
+        if (unidade == POR_CELULA)
+        {
+            celula = fixo;
+            idx_digito = k;
+        }
+        else
+        {
+            celula = UNIDADES[unidade][k];
+            idx_digito = fixo;
+        }
+    }
+};
+
+// Pilha das células preenchidas, usada para desfazer a propagação ao retroceder
+struct TrilhaBusca
+{
+    std::array<std::uint8_t, 81> celulas;
+    std::size_t topo = 0;
+};
+
+// Resultado de Solucao::continuar
+enum class ResultadoBusca : std::uint8_t
+{
+    Resolvido,  // A solução está em EstadoBusca::tabuleiro
+    SemSolucao, // O tabuleiro voltou a ser o inicial
+    Esgotado,   // O orçamento acabou antes; continuar de novo retoma do mesmo ponto
+};
+
+// Estado de uma busca que pode ser interrompida e retomada (veja Solucao::iniciar e Solucao::continuar).
+// Em vez da pilha de chamadas, cada chute em aberto é um quadro num array de tamanho fixo (no máximo um
+// por célula), então a busca não aloca nada e o estado pode ser guardado, copiado ou passado para outra
+// thread entre uma fatia e outra.
+struct EstadoBusca
+{
+    // Um chute em aberto: o ramo com as alternativas que ainda faltam tentar e o topo da trilha antes
+    // da propagação do nó (para desfazê-la quando acabarem as alternativas)
+    struct Quadro
+    {
+        Ramo ramo;
+        std::uint8_t marca;
+    };
+
+    Tabuleiro tabuleiro;
+    TrilhaBusca trilha;
+    std::array<Quadro, 81> quadros;
+    std::size_t profundidade = 0; // Quadros em uso
+    bool visitar = true;          // O próximo passo é propagar um nó novo (senão, tentar o próximo dígito)
+    bool terminou = false;
+    ResultadoBusca resultado = ResultadoBusca::Esgotado;
+    std::uint64_t nos = 0; // Nós visitados desde iniciar, somando todas as chamadas
+};
+
+// Classe que resolve o Sudoku com propagação de restrições e backtracking.
+// A cada passo preenche os "singles" (célula com um só candidato e dígito com um só lugar
+// na linha, coluna ou região) e só então chuta: na célula com menos candidatos (MRV) ou, se ela
+// tiver mais de 2, no dígito com menos lugares numa unidade (veja escolher).
+// Rastreio é a política que recebe cada passo (veja Rastreio.hpp) e Estatisticas a que conta
+// os nós, chutes e tempos (veja Estatisticas.hpp); as padrões não custam nada.
+template <class Rastreio = RastreioNulo, class Estatisticas = EstatisticasNulas>
+class Solucao : private Rastreio, private Estatisticas
+{
+public:
+    // Função principal: resolve o Sudoku, retorna true se conseguiu, false se não tem solução
+    bool resolverSudoku(Tabuleiro &tabuleiro)
+    {
+        Estatisticas::iniciar_busca();
+        // Preenche as máscaras com o estado inicial do tabuleiro
+        tabuleiro.recalcular_mascaras();
+        // Chama a função recursiva com a trilha de jogadas vazia
+        Trilha trilha;
+        bool resolveu = resolver(tabuleiro, trilha, 0);
+        Estatisticas::terminar_busca();
+        return resolveu;
+    }
+
+    // Valida o tabuleiro com validar_tabuleiro, contando o tempo gasto nas estatísticas
+    std::string validarTabuleiro(const Tabuleiro &tabuleiro)
+    {
+        Estatisticas::iniciar_validacao();
+        std::string motivo = validar_tabuleiro(tabuleiro);
+        Estatisticas::terminar_validacao();
+        return motivo;
+    }
+
+    // Conta as soluções do tabuleiro, parando assim que chegar ao limite (2 basta para saber se é única)
+    std::size_t contarSolucoes(Tabuleiro tabuleiro, std::size_t limite = 2)
+    {
+        Estatisticas::iniciar_busca();
+        tabuleiro.recalcular_mascaras();
+        Trilha trilha;
+        std::size_t encontradas = 0;
+        contar(tabuleiro, trilha, limite, encontradas, 0);
+        Estatisticas::terminar_busca();
+        return encontradas;
+    }
+
+    // Prepara a busca iterativa do tabuleiro; nada é resolvido até a primeira chamada de continuar
+    void iniciar(EstadoBusca &estado, const Tabuleiro &tabuleiro) const
+    {
+        estado.tabuleiro = tabuleiro;
+        estado.tabuleiro.recalcular_mascaras();
+        estado.trilha.topo = 0;
+        estado.profundidade = 0;
+        estado.visitar = true;
+        estado.terminou = false;
+        estado.resultado = ResultadoBusca::Esgotado;
+        estado.nos = 0;
+    }
+
+    // Continua a busca com pilha explícita (a mesma ordem de resolver) até achar a solução, esgotar a
+    // árvore ou gastar o orçamento: max_nos nós ou max_tempo de relógio, o que vier primeiro. Cada chamada
+    // visita pelo menos um nó, então chamadas repetidas sempre terminam. Depois do fim, só repete o resultado.
+    ResultadoBusca continuar(EstadoBusca &estado,
+                             std::uint64_t max_nos = std::numeric_limits<std::uint64_t>::max(),
+                             std::chrono::steady_clock::duration max_tempo = std::chrono::steady_clock::duration::max())
+    {
+        if (estado.terminou)
+            return estado.resultado;
+        Estatisticas::iniciar_busca();
+        auto agora = std::chrono::steady_clock::now();
+        bool com_prazo = max_tempo < std::chrono::steady_clock::time_point::max() - agora;
+        auto prazo = com_prazo ? agora + max_tempo : std::chrono::steady_clock::time_point::max();
+
+        Tabuleiro &tabuleiro = estado.tabuleiro;
+        TrilhaBusca &trilha = estado.trilha;
+        std::uint64_t visitados = 0;
+        while (true)
+        {
+            if (estado.visitar)
+            {
+                // O orçamento só é conferido entre um nó e outro, onde o estado está pronto para retomar.
+                // O relógio é lido a cada 32 nós para não pesar nos nós baratos.
+                if (visitados > 0 && (visitados >= max_nos ||
+                                      (com_prazo && visitados % 32 == 0 && std::chrono::steady_clock::now() >= prazo)))
+                {
+                    Estatisticas::terminar_busca();
+                    return ResultadoBusca::Esgotado;
+                }
+                ++visitados;
+                ++estado.nos;
+                Estatisticas::no(estado.profundidade);
+                std::size_t marca = trilha.topo;
+                if (propagar(tabuleiro, trilha))
+                {
+                    Ramo ramo;
+                    if (!escolher(tabuleiro, ramo))
+                        return terminar(estado, ResultadoBusca::Resolvido);
+                    estado.quadros[estado.profundidade++] = {ramo, static_cast<std::uint8_t>(marca)};
+                }
+                else
+                {
+                    desfazer_ate(tabuleiro, trilha, marca);
+                    if (!retroceder(estado))
+                        return terminar(estado, ResultadoBusca::SemSolucao);
+                }
+                estado.visitar = false;
+            }
+
+            // Próxima alternativa do chute mais recente; sem nenhuma, desfaz o nó e volta para o anterior
+            EstadoBusca::Quadro &quadro = estado.quadros[estado.profundidade - 1];
+            if (quadro.ramo.alternativas)
+            {
+                std::size_t celula, idx_digito;
+                quadro.ramo.jogada(static_cast<std::size_t>(__builtin_ctz(quadro.ramo.alternativas)), celula, idx_digito);
+                quadro.ramo.alternativas &= static_cast<Mascara>(quadro.ramo.alternativas - 1);
+                colocar(tabuleiro, trilha, celula, idx_digito);
+                Estatisticas::chute();
+                estado.visitar = true;
+            }
+            else
+            {
+                desfazer_ate(tabuleiro, trilha, quadro.marca);
+                --estado.profundidade;
+                if (!retroceder(estado))
+                    return terminar(estado, ResultadoBusca::SemSolucao);
+            }
+        }
+    }
+
+    // Sinal de cancelamento compartilhado com outras buscas (veja BuscaParalela.hpp): quando ele fica true,
+    // resolverSudoku e contarSolucoes voltam no próximo nó. Com nullptr (o padrão) não há cancelamento.
+    void cancelar_com(const std::atomic<bool> *sinal) noexcept
+    {
+        cancelado = sinal;
+    }
+
+    // Divide a busca em subárvores independentes: expande a árvore em largura, nível por nível (propagando
+    // e chutando onde a busca chutaria), até ter pelo menos 'minimo' tabuleiros ou não haver mais
+    // o que expandir. Os tabuleiros cobrem exatamente as soluções da raiz, sem repetição: os ramos com
+    // contradição somem e um tabuleiro cheio já é uma solução.
+    void dividir(const Tabuleiro &raiz, std::size_t minimo, std::vector<Tabuleiro> &tarefas)
+    {
+        tarefas.clear();
+        tarefas.push_back(raiz);
+        tarefas.back().recalcular_mascaras();
+        std::vector<Tabuleiro> proximo_nivel;
+        bool expandiu = true;
+        while (expandiu && !tarefas.empty() && tarefas.size() < minimo)
+        {
+            expandiu = false;
+            proximo_nivel.clear();
+            for (Tabuleiro &tabuleiro : tarefas)
+            {
+                Trilha trilha;
+                if (!propagar(tabuleiro, trilha))
+                    continue;
+                Ramo ramo;
+                if (!escolher(tabuleiro, ramo))
+                {
+                    proximo_nivel.push_back(tabuleiro);
+                    continue;
+                }
+                while (ramo.alternativas)
+                {
+                    std::size_t celula, idx_digito;
+                    ramo.jogada(static_cast<std::size_t>(__builtin_ctz(ramo.alternativas)), celula, idx_digito);
+                    ramo.alternativas &= static_cast<Mascara>(ramo.alternativas - 1);
+                    proximo_nivel.push_back(tabuleiro);
+                    proximo_nivel.back().colocar(celula / 9, celula % 9, idx_digito);
+                    expandiu = true;
+                }
+            }
+            tarefas.swap(proximo_nivel);
+        }
+    }
+
+    // Acesso à política de rastreio (por exemplo, para ler os passos gravados)
+    Rastreio &rastreio() noexcept
+    {
+        return *this;
+    }
+
+    // Acesso à política de estatísticas (por exemplo, para zerar ou ler os contadores)
+    Estatisticas &estatisticas() noexcept
+    {
+        return *this;
+    }
+
+private:
+    const std::atomic<bool> *cancelado = nullptr;
+
+    bool foi_cancelado() const noexcept
+    {
+        return cancelado && cancelado->load(std::memory_order_relaxed);
+    }
+
+    using Trilha = TrilhaBusca;
+
+    // Fim da busca iterativa: guarda o resultado para as próximas chamadas de continuar
+    ResultadoBusca terminar(EstadoBusca &estado, ResultadoBusca resultado)
+    {
+        estado.terminou = true;
+        estado.resultado = resultado;
+        Estatisticas::terminar_busca();
+        return resultado;
+    }
+
+    // Na busca iterativa, desfaz o chute do quadro do topo depois que o nó filho falhou;
+    // retorna false se não há chute em aberto (a árvore toda foi percorrida)
+    bool retroceder(EstadoBusca &estado)
+    {
+        if (estado.profundidade == 0)
+            return false;
+        std::size_t celula = estado.trilha.celulas[estado.trilha.topo - 1]; // O chute é a última jogada da trilha
+        Estatisticas::retrocesso();
+        Rastreio::retroceder(estado.tabuleiro, celula / 9, celula % 9);
+        desfazer_ate(estado.tabuleiro, estado.trilha, estado.trilha.topo - 1);
+        return true;
+    }
+
+    // Preenche a célula com o dígito (índice 0..8) e guarda a jogada na trilha
+    void colocar(Tabuleiro &tabuleiro, Trilha &trilha, std::size_t celula, std::size_t idx_digito)
+    {
+        std::size_t linha = celula / 9, coluna = celula % 9;
+        tabuleiro.colocar(linha, coluna, idx_digito);
+        trilha.celulas[trilha.topo++] = static_cast<std::uint8_t>(celula);
+        Rastreio::colocar(tabuleiro, linha, coluna, idx_digito);
+    }
+
+    // Desfaz todas as jogadas da trilha feitas depois da marca
+    void desfazer_ate(Tabuleiro &tabuleiro, Trilha &trilha, std::size_t marca)
+    {
+        while (trilha.topo > marca)
+        {
+            std::size_t celula = trilha.celulas[--trilha.topo];
+            tabuleiro.remover(celula / 9, celula % 9, static_cast<std::size_t>(tabuleiro.celulas[celula] - '1'));
+            Rastreio::remover(tabuleiro, celula / 9, celula % 9);
+        }
+    }
+
+    // Propaga as restrições até não haver mais singles; retorna false se encontrar uma contradição
+    bool propagar(Tabuleiro &tabuleiro, Trilha &trilha)
+    {
+        bool mudou = true;
+        while (mudou)
+        {
+            mudou = false;
+
+            // Naked singles: células vazias com um único candidato
+            for (std::size_t celula = 0; celula < 81; ++celula)
+            {
+                if (tabuleiro.celulas[celula] != '.')
+                    continue;
+                Mascara candidatos = tabuleiro.candidatos(celula);
+                if (candidatos == 0)
+                    return false; // Célula sem nenhum dígito possível
+                if ((candidatos & (candidatos - 1)) == 0)
+                {
+                    colocar(tabuleiro, trilha, celula, static_cast<std::size_t>(__builtin_ctz(candidatos)));
+                    Estatisticas::propagado();
+                    mudou = true;
+                }
+            }
+
+            // Hidden singles: dígitos que só cabem em uma célula da linha, coluna ou região
+            for (std::size_t unidade = 0; unidade < 27; ++unidade)
+            {
+                Mascara faltam = static_cast<Mascara>(~tabuleiro.contem_unidade(unidade) & TODOS_DIGITOS);
+                if (faltam == 0)
+                    continue;
+
+                // uma_vez: dígitos possíveis em alguma célula; duas_vezes: em mais de uma
+                Mascara uma_vez = 0, duas_vezes = 0;
+                for (std::uint8_t celula : UNIDADES[unidade])
+                {
+                    if (tabuleiro.celulas[celula] != '.')
+                        continue;
+                    Mascara candidatos = tabuleiro.candidatos(celula);
+                    duas_vezes |= uma_vez & candidatos;
+                    uma_vez |= candidatos;
+                }
+                if ((uma_vez & faltam) != faltam)
+                    return false; // Algum dígito que falta não tem onde ficar
+
+                Mascara unicos = uma_vez & static_cast<Mascara>(~duas_vezes);
+                while (unicos)
+                {
+                    std::size_t idx_digito = static_cast<std::size_t>(__builtin_ctz(unicos));
+                    unicos &= static_cast<Mascara>(unicos - 1);
+
+                    // Procura a célula que aceita o dígito (pode ter sumido por uma jogada anterior)
+                    std::size_t destino = 81;
+                    for (std::uint8_t celula : UNIDADES[unidade])
+                    {
+                        if (tabuleiro.celulas[celula] == '.' && (tabuleiro.candidatos(celula) & (1u << idx_digito)))
+                        {
+                            destino = celula;
+                            break;
+                        }
+                    }
+                    if (destino == 81)
+                        return false;
+                    colocar(tabuleiro, trilha, destino, idx_digito);
+                    Estatisticas::propagado();
+                    mudou = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Retorna a célula vazia com o menor número de candidatos (81 se o tabuleiro está cheio)
+    static std::size_t escolher_celula(const Tabuleiro &tabuleiro) noexcept
+    {
+        std::size_t melhor = 81;
+        int menor = 10;
+        for (std::size_t celula = 0; celula < 81 && menor > 2; ++celula)
+        {
+            if (tabuleiro.celulas[celula] != '.')
+                continue;
+            int quantidade = __builtin_popcount(tabuleiro.candidatos(celula));
+            if (quantidade < menor)
+            {
+                menor = quantidade;
+                melhor = celula;
+            }
+        }
+        return melhor;
+    }
+
+    // Escolhe onde chutar; retorna false se o tabuleiro está cheio. Começa pela célula com menos candidatos
+    // (MRV); se ela tiver mais de 2, procura também o dígito que cabe em menos células de alguma unidade
+    // (como SolucaoN::escolher e a coluna de menor tamanho do Dancing Links). Nos tabuleiros com poucas
+    // pistas, e principalmente nos sem solução, quase nunca há célula com 2 candidatos, mas quase sempre
+    // há um dígito com 2 lugares numa unidade, e chutar nele corta a busca muitas vezes.
+    static bool escolher(const Tabuleiro &tabuleiro, Ramo &ramo) noexcept
+    {
+        std::size_t melhor = escolher_celula(tabuleiro);
+        if (melhor == 81)
+            return false;
+        ramo = {Ramo::POR_CELULA, static_cast<std::uint8_t>(melhor), tabuleiro.candidatos(melhor)};
+        int menor = __builtin_popcount(ramo.alternativas);
+        if (menor <= 2)
+            return true;
+
+        // Depois da propagação todo dígito que falta cabe em pelo menos 2 células da unidade, então basta
+        // saber quais cabem em 2 e em 3: contagem em bits, em_mais_de[k] com os dígitos de mais de k lugares
+        std::size_t melhor_unidade = Ramo::POR_CELULA, melhor_digito = 0;
+        for (std::size_t unidade = 0; unidade < 27 && menor > 2; ++unidade)
+        {
+            Mascara em_mais_de[4] = {};
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                if (tabuleiro.celulas[celula] != '.')
+                    continue;
+                Mascara candidatos = tabuleiro.candidatos(celula);
+                em_mais_de[3] |= em_mais_de[2] & candidatos;
+                em_mais_de[2] |= em_mais_de[1] & candidatos;
+                em_mais_de[1] |= em_mais_de[0] & candidatos;
+                em_mais_de[0] |= candidatos;
+            }
+            Mascara dois_lugares = em_mais_de[1] & static_cast<Mascara>(~em_mais_de[2]);
+            Mascara tres_lugares = em_mais_de[2] & static_cast<Mascara>(~em_mais_de[3]);
+            if (dois_lugares || (tres_lugares && menor > 3))
+            {
+                menor = dois_lugares ? 2 : 3;
+                melhor_unidade = unidade;
+                melhor_digito = static_cast<std::size_t>(__builtin_ctz(dois_lugares ? dois_lugares : tres_lugares));
+            }
+        }
+        if (melhor_unidade == Ramo::POR_CELULA)
+            return true;
+
+        Mascara lugares = 0;
+        for (std::size_t k = 0; k < 9; ++k)
+        {
+            std::uint8_t celula = UNIDADES[melhor_unidade][k];
+            if (tabuleiro.celulas[celula] == '.' && (tabuleiro.candidatos(celula) >> melhor_digito & 1u))
+                lugares |= static_cast<Mascara>(1u << k);
+        }
+        ramo = {static_cast<std::uint8_t>(melhor_unidade), static_cast<std::uint8_t>(melhor_digito), lugares};
+        return true;
+    }
+
+    // Como resolver, mas percorre todos os ramos somando as soluções até chegar ao limite.
+    // Sempre desfaz o que fez, deixando o tabuleiro como recebeu.
+    void contar(Tabuleiro &tabuleiro, Trilha &trilha, std::size_t limite, std::size_t &encontradas,
+                std::size_t profundidade)
+    {
+        if (foi_cancelado())
+            return;
+        Estatisticas::no(profundidade);
+        std::size_t marca = trilha.topo;
+        if (propagar(tabuleiro, trilha))
+        {
+            Ramo ramo;
+            if (!escolher(tabuleiro, ramo))
+            {
+                ++encontradas; // Tabuleiro cheio: mais uma solução
+            }
+            else
+            {
+                while (ramo.alternativas && encontradas < limite)
+                {
+                    std::size_t celula, idx_digito;
+                    ramo.jogada(static_cast<std::size_t>(__builtin_ctz(ramo.alternativas)), celula, idx_digito);
+                    ramo.alternativas &= static_cast<Mascara>(ramo.alternativas - 1);
+                    colocar(tabuleiro, trilha, celula, idx_digito);
+                    Estatisticas::chute();
+                    contar(tabuleiro, trilha, limite, encontradas, profundidade + 1);
+                    Estatisticas::retrocesso();
+                    Rastreio::retroceder(tabuleiro, celula / 9, celula % 9);
+                    desfazer_ate(tabuleiro, trilha, trilha.topo - 1);
+                }
+            }
+        }
+        desfazer_ate(tabuleiro, trilha, marca);
+    }
+
+    // Função recursiva: propaga, escolhe onde chutar e tenta cada alternativa.
+    // A profundidade é o número de chutes ainda em aberto acima deste nó.
+    bool resolver(Tabuleiro &tabuleiro, Trilha &trilha, std::size_t profundidade)
+    {
+        if (foi_cancelado())
+            return false;
+        Estatisticas::no(profundidade);
+        std::size_t marca = trilha.topo;
+        if (!propagar(tabuleiro, trilha))
+        {
+            desfazer_ate(tabuleiro, trilha, marca);
+            return false;
+        }
+
+        // Escolhe a célula com menos candidatos (MRV) ou o dígito com menos lugares numa unidade
+        Ramo ramo;
+
+        // Se não há célula vazia, a solução foi encontrada
+        if (!escolher(tabuleiro, ramo))
+        {
+            return true;
+        }
+
+        while (ramo.alternativas)
+        {
+            std::size_t celula, idx_digito;
+            ramo.jogada(static_cast<std::size_t>(__builtin_ctz(ramo.alternativas)), celula, idx_digito);
+            ramo.alternativas &= static_cast<Mascara>(ramo.alternativas - 1);
+
+            // Chuta a alternativa e continua a busca
+            colocar(tabuleiro, trilha, celula, idx_digito);
+            Estatisticas::chute();
+            if (resolver(tabuleiro, trilha, profundidade + 1))
+            {
+                return true; // Encontrou solução!
+            }
+
+            // Caso não dê certo, desfaz o chute (backtracking)
+            Estatisticas::retrocesso();
+            Rastreio::retroceder(tabuleiro, celula / 9, celula % 9);
+            desfazer_ate(tabuleiro, trilha, trilha.topo - 1);
+        }
+
+        // Nenhum chute funcionou: desfaz também a propagação deste nível
+        desfazer_ate(tabuleiro, trilha, marca);
+        return false;
+    }
+};
@@ -0,0 +1,199 @@
+// SolucaoDLX.hpp
+
+#pragma once
+
+#include <array>   // Para o pool fixo de nós
+#include <cstddef> // Para std::size_t
+
+#include "Tabuleiro.hpp" // Tabuleiro plano com as máscaras de linha, coluna e região
+
+// Classe que resolve o Sudoku como cobertura exata com Dancing Links (Algoritmo X de Knuth).
+// Cada uma das 729 linhas da matriz é "dígito d na célula c" e cobre 4 das 324 restrições:
+// célula preenchida, dígito na linha, dígito na coluna e dígito na região.
+// A matriz inteira é montada uma única vez no construtor, num pool fixo de nós; as pistas são
+// aplicadas cobrindo colunas e, ao final, tudo é descoberto de volta, sem nenhuma alocação.
+class SolucaoDLX
+{
+public:
+    SolucaoDLX() noexcept
+    {
+        // Raiz e cabeçalhos das colunas formam uma lista circular horizontal
+        for (int c = 0; c <= COLUNAS; ++c)
+        {
+            esq[c] = c == 0 ? COLUNAS : c - 1;
+            dir[c] = c == COLUNAS ? 0 : c + 1;
+            cima[c] = baixo[c] = c;
+            coluna[c] = c;
+            tamanho[c] = 0;
+        }
+
+        // Cada linha da matriz tem 4 nós, ligados em círculo e inseridos no fim de cada coluna
+        for (int linha = 0; linha < LINHAS; ++linha)
+        {
+            int celula = linha / 9, digito = linha % 9;
+            int l = celula / 9, c = celula % 9;
+            int colunas[4] = {1 + celula,
+                              1 + 81 + l * 9 + digito,
+                              1 + 162 + c * 9 + digito,
+                              1 + 243 + static_cast<int>(obter_regiao(static_cast<std::size_t>(l), static_cast<std::size_t>(c))) * 9 + digito};
+            int primeiro = 1 + COLUNAS + linha * 4;
+            for (int k = 0; k < 4; ++k)
+            {
+                int no = primeiro + k;
+                int col = colunas[k];
+                linha_do_no[no] = linha;
+                coluna[no] = col;
+                esq[no] = primeiro + (k + 3) % 4;
+                dir[no] = primeiro + (k + 1) % 4;
+                cima[no] = cima[col];
+                baixo[no] = col;
+                baixo[cima[col]] = no;
+                cima[col] = no;
+                ++tamanho[col];
+            }
+        }
+    }
+
+    // Resolve o Sudoku, retorna true se conseguiu, false se não tem solução (ou se as pistas se contradizem)
+    bool resolverSudoku(Tabuleiro &tabuleiro) noexcept
+    {
+        // Aplica as pistas: escolhe a linha de cada uma, cobrindo as suas colunas
+        int pistas = 0;
+        bool valido = true;
+        for (int celula = 0; celula < 81 && valido; ++celula)
+        {
+            char c = tabuleiro.celulas[static_cast<std::size_t>(celula)];
+            if (c == '.')
+                continue;
+            int primeiro = 1 + COLUNAS + (celula * 9 + (c - '1')) * 4;
+            // Se alguma coluna da linha já foi coberta, duas pistas disputam a mesma restrição
+            for (int k = 0; k < 4 && valido; ++k)
+                valido = !coberta(coluna[primeiro + k]);
+            if (valido)
+            {
+                selecionar(primeiro);
+                escolhidas[pistas++] = primeiro;
+            }
+        }
+
+        profundidade = pistas;
+        bool resolveu = valido && buscar();
+
+        // Escreve a solução no tabuleiro
+        if (resolveu)
+        {
+            for (int i = pistas; i < profundidade; ++i)
+            {
+                int linha = linha_do_no[escolhidas[i]];
+                tabuleiro.celulas[static_cast<std::size_t>(linha / 9)] = static_cast<char>('1' + linha % 9);
+            }
+            tabuleiro.recalcular_mascaras();
+        }
+
+        // Desfaz tudo em ordem inversa, deixando a matriz pronta para o próximo tabuleiro
+        for (int i = profundidade - 1; i >= 0; --i)
+            deselecionar(escolhidas[i]);
+        profundidade = 0;
+        return resolveu;
+    }
+
+private:
+    static constexpr int COLUNAS = 324;                 // Restrições
+    static constexpr int LINHAS = 729;                  // Candidatos (célula, dígito)
+    static constexpr int NOS = 1 + COLUNAS + LINHAS * 4; // Raiz + cabeçalhos + nós das linhas
+
+    // Listas duplamente ligadas em índices do pool (0 é a raiz, 1..324 são os cabeçalhos)
+    std::array<int, NOS> esq, dir, cima, baixo, coluna, linha_do_no;
+    std::array<int, COLUNAS + 1> tamanho;
+
+    // Pilha das linhas escolhidas (pistas primeiro, depois os chutes da busca)
+    std::array<int, 81> escolhidas;
+    int profundidade = 0;
+
+    // A coluna foi removida da lista de cabeçalhos?
+    bool coberta(int c) const noexcept
+    {
+        return dir[esq[c]] != c;
+    }
+
+    // Remove a coluna e todas as linhas que a satisfazem
+    void cobrir(int c) noexcept
+    {
+        dir[esq[c]] = dir[c];
+        esq[dir[c]] = esq[c];
+        for (int i = baixo[c]; i != c; i = baixo[i])
+        {
+            for (int j = dir[i]; j != i; j = dir[j])
+            {
+                cima[baixo[j]] = cima[j];
+                baixo[cima[j]] = baixo[j];
+                --tamanho[coluna[j]];
+            }
+        }
+    }
+
+    // Desfaz cobrir(c), na ordem exatamente inversa
+    void descobrir(int c) noexcept
+    {
+        for (int i = cima[c]; i != c; i = cima[i])
+        {
+            for (int j = esq[i]; j != i; j = esq[j])
+            {
+                ++tamanho[coluna[j]];
+                cima[baixo[j]] = j;
+                baixo[cima[j]] = j;
+            }
+        }
+        dir[esq[c]] = c;
+        esq[dir[c]] = c;
+    }
+
+    // Escolhe a linha do nó: cobre as 4 colunas dela
+    void selecionar(int no) noexcept
+    {
+        cobrir(coluna[no]);
+        for (int j = dir[no]; j != no; j = dir[j])
+            cobrir(coluna[j]);
+    }
+
+    // Desfaz selecionar(no)
+    void deselecionar(int no) noexcept
+    {
+        for (int j = esq[no]; j != no; j = esq[j])
+            descobrir(coluna[j]);
+        descobrir(coluna[no]);
+    }
+
+    // Algoritmo X: escolhe a coluna com menos linhas e tenta cada uma delas
+    bool buscar() noexcept
+    {
+        // Todas as restrições satisfeitas: solução encontrada
+        if (dir[0] == 0)
+            return true;
+
+        int melhor = dir[0];
+        for (int c = dir[melhor]; c != 0 && tamanho[melhor] > 1; c = dir[c])
+        {
+            if (tamanho[c] < tamanho[melhor])
+                melhor = c;
+        }
+        if (tamanho[melhor] == 0)
+            return false; // Restrição que nenhuma linha consegue satisfazer
+
+        // cobrir/descobrir a coluna escolhida faz parte do Algoritmo X; os outros nós são tratados por linha
+        cobrir(melhor);
+        for (int i = baixo[melhor]; i != melhor; i = baixo[i])
+        {
+            escolhidas[profundidade++] = i;
+            for (int j = dir[i]; j != i; j = dir[j])
+                cobrir(coluna[j]);
+            if (buscar())
+                return true; // A pilha fica com a solução; resolverSudoku desfaz tudo depois
+            for (int j = esq[i]; j != i; j = esq[j])
+                descobrir(coluna[j]);
+            --profundidade;
+        }
+        descobrir(melhor);
+        return false;
+    }
+};
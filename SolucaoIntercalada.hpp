@@ -0,0 +1,253 @@
+// SolucaoIntercalada.hpp
+
+#pragma once
+
+#include <array>   // Para o dono de cada pista
+#include <cstdint> // Para std::uint16_t e std::uint32_t
+#include <cstddef> // Para std::size_t
+#include <string>  // Para o motivo da validação
+
+#include "Tabuleiro.hpp"   // Tabuleiro plano e a tabela das 27 unidades
+#include "Solucao.hpp"     // Validação e busca dos tabuleiros que precisam de chute
+#include "SolucaoSimd.hpp" // Vetor16, SIMD_INLINE e a detecção do conjunto de instruções
+
+// Estado de 16 quebra-cabeças ao mesmo tempo, em estrutura de arrays: o vetor da célula c guarda, na
+// pista p, a máscara de candidatos da célula c do quebra-cabeça p. Cada operação do núcleo avança a
+// mesma célula dos 16 quebra-cabeças de uma vez, sem desvios que dependam de um quebra-cabeça só.
+// O alinhamento é explícito: compilado sem AVX, o Vetor16 só teria 16 bytes de alinhamento, e o núcleo
+// AVX2 lê o estado com instruções que exigem 32.
+struct alignas(32) EstadoIntercalado
+{
+    Vetor16 candidatos[81];
+};
+
+namespace intercalado
+{
+    // Situação de cada pista depois de uma rodada (bit p = pista p)
+    struct Rodada
+    {
+        std::uint32_t resolvidas;  // Todas as células com um só dígito e nenhuma repetição
+        std::uint32_t contradicoes; // Célula sem candidato, dígito sem lugar ou repetido numa unidade
+        std::uint32_t mudaram;     // Algum candidato foi eliminado nesta rodada
+    };
+
+    // Bit p ligado se a pista p do vetor não é zero
+    SIMD_INLINE std::uint32_t pistas_ligadas(const Vetor16 &v)
+    {
+        std::uint32_t bits = 0;
+        for (std::size_t p = 0; p < 16; ++p)
+            bits |= static_cast<std::uint32_t>(v[p] != 0) << p;
+        return bits;
+    }
+
+    // Uma rodada de propagação nas 16 pistas: elimina os dígitos dos naked singles dos vizinhos e
+    // fixa os hidden singles de cada unidade. Pistas sem quebra-cabeça também são processadas; o
+    // resultado delas é só ignorado por quem chama.
+    SIMD_INLINE Rodada rodada(EstadoIntercalado &e)
+    {
+        const Vetor16 todos = Vetor16{} + TODOS_DIGITOS;
+        Vetor16 unicos[81]; // O dígito das células com um só candidato (0 nas outras)
+        Vetor16 fixos[27];  // Dígitos dos naked singles de cada unidade
+        Vetor16 todas_unicas = ~Vetor16{};
+        Vetor16 repetidos{};
+        Vetor16 contradicao{};
+        Vetor16 mudou{};
+
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            Vetor16 m = e.candidatos[celula];
+            Vetor16 um_so = (Vetor16)((m & (m - 1)) == 0);
+            unicos[celula] = m & um_so;
+            todas_unicas &= um_so & (Vetor16)(m != 0);
+        }
+        for (std::size_t unidade = 0; unidade < 27; ++unidade)
+        {
+            Vetor16 vistos{};
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                repetidos |= vistos & unicos[celula];
+                vistos |= unicos[celula];
+            }
+            fixos[unidade] = vistos;
+        }
+        Vetor16 sem_repeticao = (Vetor16)(repetidos == 0);
+        contradicao |= ~sem_repeticao;
+
+        // Naked singles: cada célula perde os dígitos fixados nas suas três unidades (menos o seu)
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            std::size_t linha = celula / 9, coluna = celula % 9;
+            Vetor16 vizinhos = fixos[linha] | fixos[9 + coluna] | fixos[18 + obter_regiao(linha, coluna)];
+            Vetor16 m = e.candidatos[celula];
+            Vetor16 nova = m & ~(vizinhos & ~unicos[celula]);
+            mudou |= nova ^ m;
+            contradicao |= (Vetor16)(nova == 0);
+            e.candidatos[celula] = nova;
+        }
+
+        // Hidden singles: dígito que só cabe numa célula da unidade fica sozinho nela
+        for (std::size_t unidade = 0; unidade < 27; ++unidade)
+        {
+            Vetor16 uma_vez{}, duas_vezes{};
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                duas_vezes |= uma_vez & e.candidatos[celula];
+                uma_vez |= e.candidatos[celula];
+            }
+            contradicao |= (Vetor16)(uma_vez != todos); // Algum dígito sem lugar na unidade
+            Vetor16 so_aqui = uma_vez & ~duas_vezes;
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                Vetor16 m = e.candidatos[celula];
+                Vetor16 achados = m & so_aqui;
+                contradicao |= (Vetor16)((achados & (achados - 1)) != 0); // Dois dígitos presos na mesma célula
+                Vetor16 nova = achados | (m & (Vetor16)(achados == 0));
+                mudou |= nova ^ m;
+                e.candidatos[celula] = nova;
+            }
+        }
+
+        return {pistas_ligadas(todas_unicas & sem_repeticao), pistas_ligadas(contradicao), pistas_ligadas(mudou)};
+    }
+
+    // Uma cópia do núcleo para cada conjunto de instruções, como em SolucaoSimd
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"))) inline Rodada rodada_avx2(EstadoIntercalado &e)
+    {
+        return rodada(e);
+    }
+
+    __attribute__((target("sse4.1"))) inline Rodada rodada_sse4(EstadoIntercalado &e)
+    {
+        return rodada(e);
+    }
+#endif
+
+    inline Rodada rodada_portavel(EstadoIntercalado &e)
+    {
+        return rodada(e);
+    }
+}
+
+// Resolve muitos quebra-cabeças fáceis e médios num núcleo só, 16 de cada vez, em rodadas de propagação
+// que avançam todos juntos (veja EstadoIntercalado). Um quebra-cabeça sai da sua pista assim que termina,
+// assim que a propagação acha uma contradição (sem solução) ou quando ela para de avançar: nesse caso ele
+// precisa de chute e vai, com o que já foi propagado, para a busca do Solucao. A pista livre recebe o
+// próximo quebra-cabeça do lote na mesma hora.
+class SolucaoIntercalada
+{
+public:
+    static constexpr std::size_t PISTAS = 16;
+
+    SolucaoIntercalada() noexcept : SolucaoIntercalada(SolucaoSimd::detectar_isa()) {}
+
+    explicit SolucaoIntercalada(SolucaoSimd::Isa isa) noexcept
+    {
+        switch (isa)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+        case SolucaoSimd::Isa::Avx2:
+            nucleo = intercalado::rodada_avx2;
+            break;
+        case SolucaoSimd::Isa::Sse4:
+            nucleo = intercalado::rodada_sse4;
+            break;
+#endif
+        default:
+            nucleo = intercalado::rodada_portavel;
+            break;
+        }
+    }
+
+    // Resolve os n tabuleiros no lugar; resolvidos[i] diz se o i-ésimo tem solução. Os tabuleiros já
+    // devem ter passado por validar_tabuleiro. Sem solução, o tabuleiro pode ficar com dígitos propagados.
+    void resolverVarios(Tabuleiro *tabuleiros, bool *resolvidos, std::size_t n)
+    {
+        std::array<std::size_t, PISTAS> dono;
+        dono.fill(LIVRE);
+        std::size_t proximo = 0, ocupadas = 0;
+        for (;;)
+        {
+            for (std::size_t pista = 0; pista < PISTAS && proximo < n; ++pista)
+            {
+                if (dono[pista] != LIVRE)
+                    continue;
+                carregar(pista, tabuleiros[proximo]);
+                dono[pista] = proximo++;
+                ++ocupadas;
+            }
+            if (ocupadas == 0)
+                return;
+
+            intercalado::Rodada situacao = nucleo(estado);
+            for (std::size_t pista = 0; pista < PISTAS; ++pista)
+            {
+                if (dono[pista] == LIVRE)
+                    continue;
+                std::uint32_t bit = 1u << pista;
+                Tabuleiro &tabuleiro = tabuleiros[dono[pista]];
+                bool &resolvido = resolvidos[dono[pista]];
+                if (situacao.resolvidas & bit)
+                {
+                    descarregar(pista, tabuleiro);
+                    resolvido = true;
+                }
+                else if (situacao.contradicoes & bit)
+                    resolvido = false;
+                else if (!(situacao.mudaram & bit))
+                {
+                    // Parou de avançar: continua com chutes a partir do que já foi propagado
+                    descarregar(pista, tabuleiro);
+                    resolvido = busca.resolverSudoku(tabuleiro);
+                }
+                else
+                    continue;
+                dono[pista] = LIVRE;
+                --ocupadas;
+            }
+        }
+    }
+
+    // Mesma interface de Solucao::resolverSudoku (um lote de um: as outras 15 pistas ficam ociosas)
+    bool resolverSudoku(Tabuleiro &tabuleiro)
+    {
+        bool resolvido = false;
+        resolverVarios(&tabuleiro, &resolvido, 1);
+        return resolvido;
+    }
+
+    // Mesma interface de Solucao::validarTabuleiro (sem estatísticas)
+    std::string validarTabuleiro(const Tabuleiro &tabuleiro) const
+    {
+        return validar_tabuleiro(tabuleiro);
+    }
+
+private:
+    static constexpr std::size_t LIVRE = ~std::size_t{0};
+
+    EstadoIntercalado estado{};
+    intercalado::Rodada (*nucleo)(EstadoIntercalado &);
+    Solucao<> busca;
+
+    // Coloca o quebra-cabeça na pista: as pistas viram um só candidato e as células vazias, todos
+    void carregar(std::size_t pista, const Tabuleiro &tabuleiro) noexcept
+    {
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            char c = tabuleiro.celulas[celula];
+            estado.candidatos[celula][pista] =
+                c == '.' ? TODOS_DIGITOS : static_cast<std::uint16_t>(1u << (c - '1'));
+        }
+    }
+
+    // Escreve no tabuleiro as células da pista que têm um só candidato (todas, se ela foi resolvida)
+    void descarregar(std::size_t pista, Tabuleiro &tabuleiro) const noexcept
+    {
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            std::uint16_t m = estado.candidatos[celula][pista];
+            tabuleiro.celulas[celula] = (m & (m - 1)) == 0 ? static_cast<char>('1' + __builtin_ctz(m)) : '.';
+        }
+        tabuleiro.recalcular_mascaras();
+    }
+};
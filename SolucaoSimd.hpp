@@ -0,0 +1,501 @@
+// SolucaoSimd.hpp
+
+#pragma once
+
+#include <cstdint> // Para std::uint16_t e std::uint64_t
+#include <cstddef> // Para std::size_t
+
+#include "Tabuleiro.hpp" // Tabuleiro plano com as máscaras de linha, coluna e região
+
+// Vetor de 16 pistas de 16 bits (256 bits). Cada linha do tabuleiro ocupa um vetor:
+// a pista c guarda a máscara de candidatos da coluna c (pistas 9..15 ficam sempre zeradas).
+// Usa as extensões de vetor do GCC, então o mesmo código vira AVX2, SSE ou escalar
+// dependendo do alvo com que a função que o inclui é compilada. Os vetores nunca passam por valor entre
+// funções, só por referência ou como constantes: sem AVX ligado na unidade de compilação, um vetor de
+// 256 bits passado por valor mudaria a ABI (o GCC avisa com -Wpsabi).
+typedef std::uint16_t Vetor16 __attribute__((vector_size(32)));
+typedef std::int16_t Vetor16s __attribute__((vector_size(32)));
+typedef std::uint64_t Vetor4x64 __attribute__((vector_size(32)));
+
+// Força a função a ser copiada dentro de cada núcleo, herdando o conjunto de instruções dele
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+// Estado do motor SIMD: candidatos de todas as 81 células em 9 vetores, mais as unidades já resolvidas
+struct EstadoSimd
+{
+    Vetor16 candidatos[9];     // Máscara de candidatos de cada célula (uma linha por vetor)
+    Vetor16 fixas[9];          // 0xFFFF nas células já preenchidas
+    Vetor16 coluna_contem;     // Pista c: dígitos já colocados na coluna c
+    Vetor16 regiao_contem[3];  // Faixa b, pistas 0/3/6: dígitos já colocados em cada região da faixa
+    Mascara linha_contem[9];   // Dígitos já colocados em cada linha
+};
+
+namespace simd
+{
+    // Índices das pistas: 0, 1, ..., 15
+    constexpr Vetor16 INDICES = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    // 0xFFFF nas pistas 0..8 (as colunas do tabuleiro)
+    constexpr Vetor16 PISTAS_TABULEIRO = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+
+    // Todos os dígitos nas pistas 0..8
+    constexpr Vetor16 TODOS_NO_TABULEIRO = {TODOS_DIGITOS, TODOS_DIGITOS, TODOS_DIGITOS, TODOS_DIGITOS, TODOS_DIGITOS,
+                                            TODOS_DIGITOS, TODOS_DIGITOS, TODOS_DIGITOS, TODOS_DIGITOS};
+
+    // Alguma pista diferente de zero?
+    SIMD_INLINE bool algum(const Vetor16 &v)
+    {
+        Vetor4x64 x = (Vetor4x64)v;
+        return (x[0] | x[1] | x[2] | x[3]) != 0;
+    }
+
+    // Desloca as pistas k posições para baixo (a pista i recebe a pista i + k), preenchendo com zero
+    SIMD_INLINE void deslocar1(const Vetor16 &v, Vetor16 &deslocado)
+    {
+        deslocado = __builtin_shuffle(v, Vetor16{}, Vetor16s{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16});
+    }
+
+    SIMD_INLINE void deslocar2(const Vetor16 &v, Vetor16 &deslocado)
+    {
+        deslocado = __builtin_shuffle(v, Vetor16{}, Vetor16s{2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 16});
+    }
+
+    SIMD_INLINE void deslocar4(const Vetor16 &v, Vetor16 &deslocado)
+    {
+        deslocado = __builtin_shuffle(v, Vetor16{}, Vetor16s{4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16});
+    }
+
+    SIMD_INLINE void deslocar8(const Vetor16 &v, Vetor16 &deslocado)
+    {
+        deslocado = __builtin_shuffle(v, Vetor16{}, Vetor16s{8, 9, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16});
+    }
+
+    // Junta contagens "aparece ao menos uma vez" / "aparece duas vezes" de dois grupos de células
+    SIMD_INLINE void juntar(Vetor16 &uma, Vetor16 &duas, const Vetor16 &outra_uma, const Vetor16 &outra_duas)
+    {
+        duas = duas | outra_duas | (uma & outra_uma);
+        uma = uma | outra_uma;
+    }
+
+    // Coloca o dígito (bit) na célula e o elimina de todos os vizinhos, uma linha de vetor por vez
+    SIMD_INLINE void colocar(EstadoSimd &e, std::size_t linha, std::size_t coluna, std::uint16_t bit)
+    {
+        const Vetor16 &idx = INDICES;
+        Vetor16 na_coluna = (Vetor16)(idx == static_cast<std::uint16_t>(coluna));
+        std::uint16_t inicio_regiao = static_cast<std::uint16_t>(coluna / 3 * 3);
+        Vetor16 na_regiao = (Vetor16)((idx >= inicio_regiao) & (idx < static_cast<std::uint16_t>(inicio_regiao + 3)));
+        Vetor16 digito = Vetor16{} + bit;
+        std::size_t faixa = linha / 3;
+
+        for (std::size_t r = 0; r < 9; ++r)
+        {
+            Vetor16 limpar;
+            if (r == linha)
+                limpar = PISTAS_TABULEIRO & ~na_coluna; // Toda a linha, menos a própria célula
+            else if (r / 3 == faixa)
+                limpar = na_regiao; // Mesma faixa: a região (que inclui a coluna)
+            else
+                limpar = na_coluna; // Outras faixas: só a coluna
+            e.candidatos[r] &= ~(digito & limpar);
+        }
+        e.candidatos[linha][coluna] = bit;
+        e.fixas[linha][coluna] = 0xFFFF;
+        e.linha_contem[linha] |= bit;
+        e.coluna_contem[coluna] |= bit;
+        e.regiao_contem[faixa][inicio_regiao] |= bit;
+    }
+
+    // Deixa só o dígito na célula da unidade que o aceita; retorna false se nenhuma aceita mais
+    SIMD_INLINE bool marcar_unico(EstadoSimd &e, std::size_t unidade, std::uint16_t digitos)
+    {
+        while (digitos)
+        {
+            std::uint16_t bit = static_cast<std::uint16_t>(digitos & -digitos);
+            digitos = static_cast<std::uint16_t>(digitos & (digitos - 1));
+            bool achou = false;
+            for (std::uint8_t celula : UNIDADES[unidade])
+            {
+                std::size_t r = celula / 9, c = celula % 9;
+                if (!e.fixas[r][c] && (e.candidatos[r][c] & bit))
+                {
+                    e.candidatos[r][c] = bit; // Vira um naked single, colocado na próxima rodada
+                    achou = true;
+                    break;
+                }
+            }
+            if (!achou)
+                return false;
+        }
+        return true;
+    }
+
+    // Núcleo de propagação: naked singles e hidden singles até estabilizar; false em contradição.
+    // Colunas e regiões são analisadas faixa a faixa com operações verticais entre os vetores das linhas.
+    SIMD_INLINE bool propagar(EstadoSimd &e)
+    {
+        const Vetor16 &tabuleiro = PISTAS_TABULEIRO;
+        const Vetor16 &todos = TODOS_NO_TABULEIRO;
+        for (;;)
+        {
+            bool mudou = false;
+
+            // Naked singles e células sem candidatos, uma linha (9 células) por vetor
+            for (std::size_t r = 0; r < 9; ++r)
+            {
+                Vetor16 v = e.candidatos[r];
+                Vetor16 livres = tabuleiro & ~e.fixas[r];
+                if (algum((Vetor16)(v == 0) & livres))
+                    return false;
+                Vetor16 unicos = (Vetor16)((v & (v - 1)) == 0) & livres;
+                if (!algum(unicos))
+                    continue;
+                for (std::size_t c = 0; c < 9; ++c)
+                {
+                    if (!unicos[c])
+                        continue;
+                    std::uint16_t bit = e.candidatos[r][c]; // Relê: uma colocação anterior pode ter zerado
+                    if (bit == 0)
+                        return false;
+                    colocar(e, r, c, bit);
+                    mudou = true;
+                }
+            }
+            if (mudou)
+                continue;
+
+            // Hidden singles: contagens "uma vez"/"duas vezes" por coluna e por região, faixa a faixa
+            Vetor16 uma_col{}, duas_col{};
+            for (std::size_t faixa = 0; faixa < 3; ++faixa)
+            {
+                Vetor16 uma{}, duas{};
+                for (std::size_t r = faixa * 3; r < faixa * 3 + 3; ++r)
+                    juntar(uma, duas, e.candidatos[r] & ~e.fixas[r], Vetor16{});
+                juntar(uma_col, duas_col, uma, duas);
+
+                // Junta as três colunas de cada região nas pistas 0, 3 e 6
+                Vetor16 uma1, duas1, uma2, duas2;
+                deslocar1(uma, uma1);
+                deslocar1(duas, duas1);
+                deslocar2(uma, uma2);
+                deslocar2(duas, duas2);
+                Vetor16 uma_reg = uma, duas_reg = duas;
+                juntar(uma_reg, duas_reg, uma1, duas1);
+                juntar(uma_reg, duas_reg, uma2, duas2);
+
+                Vetor16 faltam = todos & ~e.regiao_contem[faixa];
+                for (std::size_t bloco = 0; bloco < 3; ++bloco)
+                {
+                    std::size_t pista = bloco * 3;
+                    std::uint16_t falta = faltam[pista];
+                    if ((uma_reg[pista] & falta) != falta)
+                        return false; // Dígito sem lugar na região
+                    std::uint16_t unicos = static_cast<std::uint16_t>(uma_reg[pista] & ~duas_reg[pista] & falta);
+                    if (unicos)
+                    {
+                        if (!marcar_unico(e, 18 + faixa * 3 + bloco, unicos))
+                            return false;
+                        mudou = true;
+                    }
+                }
+            }
+
+            Vetor16 faltam_col = todos & ~e.coluna_contem;
+            if (algum(faltam_col & ~uma_col))
+                return false; // Dígito sem lugar na coluna
+            Vetor16 unicos_col = uma_col & ~duas_col & faltam_col;
+            if (algum(unicos_col))
+            {
+                for (std::size_t c = 0; c < 9; ++c)
+                {
+                    if (unicos_col[c] && !marcar_unico(e, 9 + c, unicos_col[c]))
+                        return false;
+                }
+                mudou = true;
+            }
+
+            // Linhas: redução horizontal das 16 pistas de cada vetor em log2(16) passos
+            for (std::size_t r = 0; r < 9; ++r)
+            {
+                Vetor16 uma = e.candidatos[r] & ~e.fixas[r], duas{};
+                Vetor16 uma_k, duas_k;
+                deslocar1(uma, uma_k);
+                deslocar1(duas, duas_k);
+                juntar(uma, duas, uma_k, duas_k);
+                deslocar2(uma, uma_k);
+                deslocar2(duas, duas_k);
+                juntar(uma, duas, uma_k, duas_k);
+                deslocar4(uma, uma_k);
+                deslocar4(duas, duas_k);
+                juntar(uma, duas, uma_k, duas_k);
+                deslocar8(uma, uma_k);
+                deslocar8(duas, duas_k);
+                juntar(uma, duas, uma_k, duas_k);
+                std::uint16_t falta = static_cast<std::uint16_t>(TODOS_DIGITOS & ~e.linha_contem[r]);
+                if ((uma[0] & falta) != falta)
+                    return false; // Dígito sem lugar na linha
+                std::uint16_t unicos = static_cast<std::uint16_t>(uma[0] & ~duas[0] & falta);
+                if (unicos)
+                {
+                    if (!marcar_unico(e, r, unicos))
+                        return false;
+                    mudou = true;
+                }
+            }
+
+            if (!mudou)
+                return true;
+        }
+    }
+
+    // Monta o estado a partir do tabuleiro; retorna false se uma pista contradiz outra
+    SIMD_INLINE bool iniciar(EstadoSimd &e, const Tabuleiro &tabuleiro)
+    {
+        const Vetor16 &todos = TODOS_NO_TABULEIRO;
+        for (std::size_t r = 0; r < 9; ++r)
+        {
+            e.candidatos[r] = todos;
+            e.fixas[r] = Vetor16{};
+            e.linha_contem[r] = 0;
+        }
+        e.coluna_contem = Vetor16{};
+        for (auto &regiao : e.regiao_contem)
+            regiao = Vetor16{};
+
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            char c = tabuleiro.celulas[celula];
+            if (c == '.')
+                continue;
+            std::size_t r = celula / 9, col = celula % 9;
+            std::uint16_t bit = static_cast<std::uint16_t>(1u << (c - '1'));
+            if (!(e.candidatos[r][col] & bit))
+                return false;
+            colocar(e, r, col, bit);
+        }
+        return true;
+    }
+
+    // Funções de entrada de um núcleo: montar o estado e propagar
+    struct Nucleo
+    {
+        bool (*iniciar)(EstadoSimd &, const Tabuleiro &);
+        bool (*propagar)(EstadoSimd &);
+    };
+
+    // Uma cópia do núcleo para cada conjunto de instruções; a escolha é feita em tempo de execução
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"))) inline bool iniciar_avx2(EstadoSimd &e, const Tabuleiro &tabuleiro)
+    {
+        return iniciar(e, tabuleiro);
+    }
+
+    __attribute__((target("avx2"))) inline bool propagar_avx2(EstadoSimd &e)
+    {
+        return propagar(e);
+    }
+
+    __attribute__((target("sse4.1"))) inline bool iniciar_sse4(EstadoSimd &e, const Tabuleiro &tabuleiro)
+    {
+        return iniciar(e, tabuleiro);
+    }
+
+    __attribute__((target("sse4.1"))) inline bool propagar_sse4(EstadoSimd &e)
+    {
+        return propagar(e);
+    }
+#endif
+
+    // Versão portável: compilada para o alvo padrão (SSE2 no x86-64, escalar em outras arquiteturas)
+    inline bool iniciar_portavel(EstadoSimd &e, const Tabuleiro &tabuleiro)
+    {
+        return iniciar(e, tabuleiro);
+    }
+
+    inline bool propagar_portavel(EstadoSimd &e)
+    {
+        return propagar(e);
+    }
+}
+
+// Classe que resolve o Sudoku com o núcleo SIMD de propagação e busca MRV (ou no dígito com 2 lugares numa
+// unidade), copiando o estado a cada chute
+class SolucaoSimd
+{
+public:
+    // Conjuntos de instruções do núcleo
+    enum class Isa
+    {
+        Portavel,
+        Sse4,
+        Avx2,
+    };
+
+    // Escolhe o melhor conjunto de instruções que o processador suporta
+    SolucaoSimd() noexcept : SolucaoSimd(detectar_isa()) {}
+
+    explicit SolucaoSimd(Isa isa_escolhida) noexcept : isa_atual(isa_escolhida)
+    {
+        switch (isa_atual)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+        case Isa::Avx2:
+            nucleo = {simd::iniciar_avx2, simd::propagar_avx2};
+            break;
+        case Isa::Sse4:
+            nucleo = {simd::iniciar_sse4, simd::propagar_sse4};
+            break;
+#endif
+        default:
+            isa_atual = Isa::Portavel;
+            nucleo = {simd::iniciar_portavel, simd::propagar_portavel};
+            break;
+        }
+    }
+
+    // Detecta o melhor núcleo disponível no processador
+    static Isa detectar_isa() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return Isa::Avx2;
+        if (__builtin_cpu_supports("sse4.1"))
+            return Isa::Sse4;
+#endif
+        return Isa::Portavel;
+    }
+
+    // Nome do conjunto de instruções em uso
+    const char *nome_isa() const noexcept
+    {
+        switch (isa_atual)
+        {
+        case Isa::Avx2:
+            return "avx2";
+        case Isa::Sse4:
+            return "sse4.1";
+        default:
+            return "portavel";
+        }
+    }
+
+    // Resolve o Sudoku, retorna true se conseguiu, false se não tem solução
+    bool resolverSudoku(Tabuleiro &tabuleiro) const noexcept
+    {
+        // Aplica as pistas; uma pista que já não é candidata contradiz outra
+        EstadoSimd estado;
+        if (!nucleo.iniciar(estado, tabuleiro))
+            return false;
+
+        if (!buscar(estado))
+            return false;
+
+        // Escreve a solução no tabuleiro
+        for (std::size_t celula = 0; celula < 81; ++celula)
+        {
+            std::uint16_t bit = estado.candidatos[celula / 9][celula % 9];
+            tabuleiro.celulas[celula] = static_cast<char>('1' + __builtin_ctz(bit));
+        }
+        tabuleiro.recalcular_mascaras();
+        return true;
+    }
+
+private:
+    Isa isa_atual;
+    simd::Nucleo nucleo;
+
+    // Propaga, escolhe a célula com menos candidatos e tenta cada um numa cópia do estado. Se a célula
+    // tiver mais de 2 candidatos e algum dígito couber em só 2 células de uma unidade, tenta essas 2
+    // células (a mesma escolha de Solucao::escolher)
+    bool buscar(EstadoSimd &estado) const noexcept
+    {
+        if (!nucleo.propagar(estado))
+            return false;
+
+        std::size_t melhor_r = 9, melhor_c = 0;
+        int menor = 10;
+        for (std::size_t r = 0; r < 9 && menor > 2; ++r)
+        {
+            for (std::size_t c = 0; c < 9; ++c)
+            {
+                if (estado.fixas[r][c])
+                    continue;
+                int quantidade = __builtin_popcount(estado.candidatos[r][c]);
+                if (quantidade < menor)
+                {
+                    menor = quantidade;
+                    melhor_r = r;
+                    melhor_c = c;
+                }
+            }
+        }
+        // Todas as células preenchidas: solução encontrada
+        if (melhor_r == 9)
+            return true;
+
+        // Com mais de 2 candidatos na melhor célula, um dígito com 2 lugares numa unidade divide melhor
+        std::uint8_t lugares[2];
+        std::uint16_t digito = menor > 2 ? dois_lugares(estado, lugares) : 0;
+        if (digito)
+        {
+            for (std::uint8_t celula : lugares)
+            {
+                EstadoSimd copia = estado;
+                copia.candidatos[celula / 9][celula % 9] = digito;
+                if (buscar(copia))
+                {
+                    estado = copia;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::uint16_t candidatos = estado.candidatos[melhor_r][melhor_c];
+        while (candidatos)
+        {
+            std::uint16_t bit = static_cast<std::uint16_t>(candidatos & -candidatos);
+            candidatos = static_cast<std::uint16_t>(candidatos & (candidatos - 1));
+            EstadoSimd copia = estado;
+            copia.candidatos[melhor_r][melhor_c] = bit; // Vira um naked single na propagação
+            if (buscar(copia))
+            {
+                estado = copia;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Procura um dígito que cabe em só 2 células vazias de alguma unidade; retorna o bit dele (0 se não há)
+    // e guarda as 2 células
+    static std::uint16_t dois_lugares(const EstadoSimd &estado, std::uint8_t lugares[2]) noexcept
+    {
+        for (const auto &unidade : UNIDADES)
+        {
+            std::uint16_t uma = 0, duas = 0, tres = 0;
+            for (std::uint8_t celula : unidade)
+            {
+                std::size_t r = celula / 9, c = celula % 9;
+                if (estado.fixas[r][c])
+                    continue;
+                std::uint16_t candidatos = estado.candidatos[r][c];
+                tres |= duas & candidatos;
+                duas |= uma & candidatos;
+                uma |= candidatos;
+            }
+            std::uint16_t exatas = static_cast<std::uint16_t>(duas & ~tres);
+            if (!exatas)
+                continue;
+            std::uint16_t digito = static_cast<std::uint16_t>(exatas & -exatas);
+            std::size_t achadas = 0;
+            for (std::uint8_t celula : unidade)
+            {
+                if (!estado.fixas[celula / 9][celula % 9] && (estado.candidatos[celula / 9][celula % 9] & digito))
+                    lugares[achadas++] = celula;
+            }
+            return digito;
+        }
+        return 0;
+    }
+};
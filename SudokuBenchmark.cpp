@@ -0,0 +1,657 @@
+// SudokuBenchmark.cpp
+
+#include <vector>    // Para a lista de quebra-cabeças e de tempos
+#include <array>     // Para os blocos do motor intercalado
+#include <iostream>  // Para mostrar os resultados
+#include <fstream>   // Para gravar o JSON
+#include <chrono>    // Para medir o tempo de cada resolução
+#include <string>    // Para as linhas de quebra-cabeças
+#include <cstdlib>   // Para malloc/free usados na contagem de alocações
+#include <new>       // Para substituir operator new/delete
+#include <atomic>    // Para o contador de alocações
+#include <locale>    // Para configurar a acentuação do terminal
+#include <memory>    // Para std::make_unique
+#include <algorithm> // Para ordenar os tempos e calcular os percentis
+#include <cstring>   // Para comparar os argumentos da linha de comando
+#include <cstdio>    // Para apagar o arquivo temporário da conferência do formato binário
+#include <filesystem> // Para a pasta temporária
+
+#include "Tabuleiro.hpp" // Tabuleiro plano de 81 células com máscaras
+#include "Motores.hpp"   // Motores de resolução usados pelo SudokuResolver
+#include "Gerador.hpp"   // Gerador do SudokuCriar, para o corpus de quebra-cabeças gerados
+#include "Carregador.hpp" // Leitura do arquivo de quebra-cabeças mapeado na memória
+#include "ArquivoBinario.hpp" // Formato binário compacto, conferido contra cabeçalhos corrompidos
+
+// Contador global de alocações feitas pelo programa
+static std::atomic<std::size_t> alocacoes{0};
+
+// Substitui o operator new para contar cada alocação no heap
+void *operator new(std::size_t tamanho)
+{
+    ++alocacoes;
+    if (void *p = std::malloc(tamanho == 0 ? 1 : tamanho))
+        return p;
+    throw std::bad_alloc();
+}
+
+// Fora de linha: inlinado, o free aparece junto do new substituído e o GCC acusa, por engano,
+// new e free misturados (-Wmismatched-new-delete)
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Corpora fixos, guardados aqui mesmo para o benchmark não depender de rede nem de arquivos.
+// Todos são conferidos com contarSolucoes antes de medir.
+
+// Fáceis: resolvidos só com singles
+const char *const CORPUS_FACIL[] = {
+    "200080300060070084030500209000105408000000000402706000301007040720040060004010003",
+    "000000907000420180000705026100904000050000040000507009920108000034059000507000000",
+    "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79",
+    "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..",
+};
+
+// Difíceis: AI Escargot, Easter Monster, o de Arto Inkala e outros conhecidos por exigir muitos chutes
+const char *const CORPUS_DIFICIL[] = {
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+    "1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1",
+    "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+    "12.3....435....1....4........54..2..6...7.........8.9...31..5.......9.7.....6...8",
+    ".2.4.37.........32........4.4.2...7.8...5.........1...5.....9...3.9....7..1..86..",
+    "..1..4.......6.3.5...9.....8.....7.3.......285...7.6..3...8...6..92......4...1...",
+};
+
+// Com 17 pistas, o mínimo para ter solução única (primeiros da lista de Gordon Royle)
+const char *const CORPUS_17_PISTAS[] = {
+    "000000010400000000020000000000050407008000300001090000300400200050100000000806000",
+    "000000010400000000020000000000050604008000300001090000300400200050100000000807000",
+    "000000012000035000000600070700000300000400800100000000000120000080000040050000600",
+    "000000012003600000000007000410020000000500300700000600280000040000300500000000000",
+    "000000012008030000000000040120500000000004700060000000507000300000620000000100000",
+    "000000012040050000000009000070600400000100000000000050000087500601000300200000000",
+    "000000012050400000000000030700600400001000000000080000920000800000510700000003000",
+    "000000012300000060000040000900000500000001070020000000000350400001400800060000000",
+    "000000012400090000000000050070200000600000400000108000018000000000030700502000000",
+    "000000012500008000000700000600120000700000450000030000030000800000500700020000000",
+};
+
+// Adversários do backtracking em ordem de leitura: a primeira linha da solução é 987654321.
+// O segundo é o mesmo girado 180 graus, para quem percorre as células do fim para o começo.
+const char *const CORPUS_ADVERSARIO[] = {
+    "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    "9...4........1.2..37......5.......9...1...4.....7.5.......2.1..58.3..............",
+};
+
+// Semente fixa do corpus gerado: os mesmos quebra-cabeças a cada execução e a cada commit
+const std::uint64_t SEMENTE_CORPUS = 2024;
+
+// Cada solucionador roda o corpus quantas vezes for preciso para ter pelo menos estas resoluções
+const std::size_t AMOSTRAS_MINIMAS = 1000;
+
+// Um conjunto de quebra-cabeças medido junto
+struct Corpus
+{
+    std::string nome;
+    std::vector<Tabuleiro> tabuleiros;
+    std::vector<Tabuleiro> solucoes; // Na mesma ordem, para medir verificar_solucao
+    double colocacoes = 0.0; // Nós da busca (dígitos colocados) por quebra-cabeça
+    double retrocessos = 0.0; // Chutes errados por quebra-cabeça
+    double validacoes = 0.0;  // Tabuleiros por segundo em validar_tabuleiro
+    double verificacoes = 0.0; // Tabuleiros por segundo em verificar_solucao
+};
+
+// Resultado de um solucionador sobre um corpus
+struct Medida
+{
+    std::string solucionador;
+    std::size_t resolucoes = 0;
+    std::size_t resolvidos = 0;
+    double vazao = 0.0; // Quebra-cabeças por segundo
+    double p50 = 0.0;   // Latências em microssegundos
+    double p99 = 0.0;
+    double maximo = 0.0;
+    double alocacoes = 0.0; // Alocações por resolução
+};
+
+// Monta um corpus a partir de linhas de 81 caracteres, descartando (com aviso) as que não têm solução única
+template <class Linhas>
+Corpus montar_corpus(const std::string &nome, const Linhas &linhas)
+{
+    Corpus corpus;
+    corpus.nome = nome;
+    Solucao<> solucao;
+    for (const auto &linha : linhas)
+    {
+        Tabuleiro tabuleiro;
+        if (!linha_para_tabuleiro(linha, tabuleiro) || !validar_tabuleiro(tabuleiro).empty() ||
+            solucao.contarSolucoes(tabuleiro) != 1)
+        {
+            std::cerr << "Ignorado no corpus " << nome << " (sem solução única): " << std::string_view(linha) << "\n";
+            continue;
+        }
+        corpus.tabuleiros.push_back(tabuleiro);
+        solucao.resolverSudoku(tabuleiro);
+        corpus.solucoes.push_back(tabuleiro);
+    }
+    return corpus;
+}
+
+// Gera 'quantidade' quebra-cabeças de cada dificuldade com o gerador do SudokuCriar e semente fixa
+std::vector<std::string> gerar_corpus(std::size_t quantidade)
+{
+    std::vector<std::string> linhas;
+    Solucao<> solucao;
+    GeradorRapido gerador;
+    for (int dificuldade = 1; dificuldade <= 3; ++dificuldade)
+    {
+        for (std::size_t i = 0; i < quantidade; ++i)
+        {
+            gerador.semear(SEMENTE_CORPUS + static_cast<std::uint64_t>(dificuldade), i);
+            Tabuleiro tabuleiro = gerar_tabuleiro_aleatorio(vazios_da_dificuldade(dificuldade), gerador, solucao);
+            linhas.emplace_back(tabuleiro.celulas.begin(), tabuleiro.celulas.end());
+        }
+    }
+    return linhas;
+}
+
+// Conta os nós da busca do motor de propagação em cada quebra-cabeça do corpus
+void contar_nos(Corpus &corpus)
+{
+    Solucao<RastreioContagem> solucao;
+    for (const Tabuleiro &original : corpus.tabuleiros)
+    {
+        Tabuleiro tabuleiro = original;
+        solucao.resolverSudoku(tabuleiro);
+    }
+    double n = static_cast<double>(std::max<std::size_t>(1, corpus.tabuleiros.size()));
+    corpus.colocacoes = static_cast<double>(solucao.rastreio().colocacoes) / n;
+    corpus.retrocessos = static_cast<double>(solucao.rastreio().retrocessos) / n;
+}
+
+// Validações por corpus: são rápidas demais para medir uma a uma, então mede o laço inteiro
+const std::size_t VALIDACOES_MINIMAS = 200000;
+
+// Mede a vazão de validar_tabuleiro sobre os quebra-cabeças e de verificar_solucao sobre as suas soluções
+void medir_validacao(Corpus &corpus)
+{
+    if (corpus.tabuleiros.empty())
+        return;
+    std::size_t repeticoes = std::max<std::size_t>(1, VALIDACOES_MINIMAS / corpus.tabuleiros.size());
+    double total = static_cast<double>(repeticoes * corpus.tabuleiros.size());
+    std::size_t erros = 0; // Usado no final, para o compilador não descartar as chamadas
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repeticoes; ++r)
+        for (const Tabuleiro &tabuleiro : corpus.tabuleiros)
+            erros += !validar_tabuleiro(tabuleiro).empty();
+    auto meio = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repeticoes; ++r)
+        for (std::size_t i = 0; i < corpus.solucoes.size(); ++i)
+            erros += !verificar_solucao(corpus.tabuleiros[i], corpus.solucoes[i]).empty();
+    auto fim = std::chrono::steady_clock::now();
+
+    corpus.validacoes = total / std::chrono::duration<double>(meio - inicio).count();
+    corpus.verificacoes = total / std::chrono::duration<double>(fim - meio).count();
+    if (erros > 0)
+        std::cerr << "Corpus " << corpus.nome << ": " << erros << " validações falharam\n";
+}
+
+// Percentil (0..1) de uma lista já ordenada
+double percentil(const std::vector<double> &ordenados, double p)
+{
+    if (ordenados.empty())
+        return 0.0;
+    std::size_t posicao = static_cast<std::size_t>(p * static_cast<double>(ordenados.size()));
+    return ordenados[std::min(posicao, ordenados.size() - 1)];
+}
+
+// Resolve o corpus várias vezes com a função dada, medindo cada resolução separadamente
+template <class Resolver>
+Medida medir(const std::string &nome, const std::vector<Tabuleiro> &tabuleiros, Resolver &&resolver)
+{
+    Medida medida;
+    medida.solucionador = nome;
+    if (tabuleiros.empty())
+        return medida;
+
+    // Uma passada de aquecimento, fora da medição
+    for (const Tabuleiro &original : tabuleiros)
+    {
+        Tabuleiro tabuleiro = original;
+        resolver(tabuleiro);
+    }
+
+    std::size_t repeticoes = std::max<std::size_t>(1, AMOSTRAS_MINIMAS / tabuleiros.size());
+    std::vector<double> latencias;
+    latencias.reserve(repeticoes * tabuleiros.size()); // Reservado antes de contar as alocações
+
+    std::size_t alocacoes_inicio = alocacoes.load();
+    double total = 0.0;
+    for (std::size_t r = 0; r < repeticoes; ++r)
+    {
+        for (const Tabuleiro &original : tabuleiros)
+        {
+            Tabuleiro tabuleiro = original; // Cópia de 135 bytes, sem heap
+            auto inicio = std::chrono::steady_clock::now();
+            bool resolveu = resolver(tabuleiro);
+            auto fim = std::chrono::steady_clock::now();
+            double micros = std::chrono::duration<double, std::micro>(fim - inicio).count();
+            latencias.push_back(micros);
+            total += micros;
+            medida.resolvidos += resolveu;
+        }
+    }
+    std::size_t total_alocacoes = alocacoes.load() - alocacoes_inicio;
+
+    std::sort(latencias.begin(), latencias.end());
+    medida.resolucoes = latencias.size();
+    medida.vazao = total > 0 ? static_cast<double>(medida.resolucoes) / (total / 1e6) : 0.0;
+    medida.p50 = percentil(latencias, 0.50);
+    medida.p99 = percentil(latencias, 0.99);
+    medida.maximo = latencias.back();
+    medida.alocacoes = static_cast<double>(total_alocacoes) / static_cast<double>(medida.resolucoes);
+    return medida;
+}
+
+// Como medir, mas entrega os tabuleiros em blocos de 64 (o corpus repetido até encher o bloco) para
+// Solucionador::resolverVarios, como faz o modo em lote. A latência de cada tabuleiro é o tempo do bloco
+// dividido pelo tamanho dele: serve para comparar a vazão com a dos motores que resolvem um por vez.
+Medida medir_blocos(const std::string &nome, const std::vector<Tabuleiro> &tabuleiros, Solucionador &solucionador)
+{
+    constexpr std::size_t TAMANHO_BLOCO = 64;
+    Medida medida;
+    medida.solucionador = nome;
+    if (tabuleiros.empty())
+        return medida;
+
+    std::array<Tabuleiro, TAMANHO_BLOCO> originais, bloco;
+    std::array<bool, TAMANHO_BLOCO> resolvidos;
+    for (std::size_t i = 0; i < TAMANHO_BLOCO; ++i)
+        originais[i] = tabuleiros[i % tabuleiros.size()];
+    bloco = originais;
+    solucionador.resolverVarios(bloco.data(), resolvidos.data(), TAMANHO_BLOCO); // Aquecimento
+
+    std::size_t repeticoes = std::max<std::size_t>(1, AMOSTRAS_MINIMAS / TAMANHO_BLOCO);
+    std::vector<double> latencias;
+    latencias.reserve(repeticoes);
+
+    std::size_t alocacoes_inicio = alocacoes.load();
+    double total = 0.0;
+    for (std::size_t r = 0; r < repeticoes; ++r)
+    {
+        bloco = originais;
+        auto inicio = std::chrono::steady_clock::now();
+        solucionador.resolverVarios(bloco.data(), resolvidos.data(), TAMANHO_BLOCO);
+        auto fim = std::chrono::steady_clock::now();
+        double micros = std::chrono::duration<double, std::micro>(fim - inicio).count();
+        latencias.push_back(micros / TAMANHO_BLOCO);
+        total += micros;
+        for (std::size_t i = 0; i < TAMANHO_BLOCO; ++i)
+            medida.resolvidos += resolvidos[i];
+    }
+    std::size_t total_alocacoes = alocacoes.load() - alocacoes_inicio;
+
+    std::sort(latencias.begin(), latencias.end());
+    medida.resolucoes = repeticoes * TAMANHO_BLOCO;
+    medida.vazao = total > 0 ? static_cast<double>(medida.resolucoes) / (total / 1e6) : 0.0;
+    medida.p50 = percentil(latencias, 0.50);
+    medida.p99 = percentil(latencias, 0.99);
+    medida.maximo = latencias.back();
+    medida.alocacoes = static_cast<double>(total_alocacoes) / static_cast<double>(medida.resolucoes);
+    return medida;
+}
+
+// Mede todos os solucionadores sobre o corpus
+std::vector<Medida> medir_corpus(const Corpus &corpus)
+{
+    std::vector<Medida> medidas;
+    const std::vector<Tabuleiro> &tabuleiros = corpus.tabuleiros;
+
+    // Cada motor sobre o mesmo conjunto de tabuleiros
+    for (Motor motor : TODOS_MOTORES)
+    {
+        auto solucionador = std::make_unique<Solucionador>(motor); // Criado antes da medição
+        medidas.push_back(medir(nome_motor(motor), tabuleiros, [&](Tabuleiro &tabuleiro)
+                                { return solucionador->resolverSudoku(tabuleiro); }));
+    }
+
+    // O motor intercalado só rende recebendo vários tabuleiros de uma vez
+    auto intercalado = std::make_unique<Solucionador>(Motor::Intercalado);
+    medidas.push_back(medir_blocos("intercalado-blocos", tabuleiros, *intercalado));
+
+    // Custo de cada política de rastreio do Solucao (a nula deve empatar com o motor propagacao)
+    Solucao<RastreioNulo> sem_rastreio;
+    medidas.push_back(medir("rastreio-nulo", tabuleiros, [&](Tabuleiro &tabuleiro)
+                            { return sem_rastreio.resolverSudoku(tabuleiro); }));
+    Solucao<RastreioBinario> com_rastreio;
+    com_rastreio.rastreio().passos().reserve(1 << 20);
+    medidas.push_back(medir("rastreio-binario", tabuleiros, [&](Tabuleiro &tabuleiro)
+                            {
+        com_rastreio.rastreio().passos().clear();
+        return com_rastreio.resolverSudoku(tabuleiro); }));
+    return medidas;
+}
+
+// Mostra as medidas de um corpus em forma de tabela
+void imprimir_corpus(const Corpus &corpus, const std::vector<Medida> &medidas)
+{
+    std::cout << "\nCorpus: " << corpus.nome << " (" << corpus.tabuleiros.size() << " quebra-cabeças, "
+              << corpus.colocacoes << " nós e " << corpus.retrocessos << " retrocessos por quebra-cabeça)\n"
+              << "Solucionador | Resolvidos | Quebra-cabeças/s | p50 (us) | p99 (us) | Máximo (us) | Alocações/resolução\n";
+    for (const Medida &m : medidas)
+    {
+        std::cout << m.solucionador << " | " << m.resolvidos << "/" << m.resolucoes << " | " << m.vazao << " | "
+                  << m.p50 << " | " << m.p99 << " | " << m.maximo << " | " << m.alocacoes << "\n";
+    }
+    std::cout << "Validação: " << corpus.validacoes << " tabuleiros/s | Verificação da solução: "
+              << corpus.verificacoes << " tabuleiros/s\n";
+}
+
+// Conferência do motor paralelo: o Easter Monster com uma pista a mais, que o deixa sem solução (todas as
+// subárvores precisam ir até o fim e nenhuma pode cancelar as outras), e o tabuleiro vazio, cuja contagem
+// chega ao limite logo e precisa cancelar o resto da busca
+const char *const SEM_SOLUCAO = "1.......2.974...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1";
+const char *const VAZIO = ".................................................................................";
+const std::size_t LIMITE_CONTAGEM = 1000;
+const unsigned THREADS_CONFERIDAS[] = {1, 2, 4, 8};
+
+// Confere o motor paralelo com 1, 2, 4 e 8 threads contra a busca sequencial: as mesmas contagens (até o
+// limite) nos tabuleiros dos corpora e neles mesmos sem as três primeiras pistas (com várias soluções),
+// nenhuma solução no tabuleiro sem solução e o limite no vazio. O mesmo SolucaoParalela atende todos os
+// tabuleiros, então as threads do grupo também são reaproveitadas depois de cada cancelamento.
+// Retorna false se alguma contagem divergir.
+bool conferir_paralelo(const std::vector<Corpus> &corpora)
+{
+    std::vector<Tabuleiro> tabuleiros;
+    for (const Corpus &corpus : corpora)
+    {
+        for (const Tabuleiro &tabuleiro : corpus.tabuleiros)
+        {
+            tabuleiros.push_back(tabuleiro);
+            Tabuleiro sem_pistas = tabuleiro;
+            for (std::size_t celula = 0, tiradas = 0; celula < 81 && tiradas < 3; ++celula)
+            {
+                if (sem_pistas.celulas[celula] != '.')
+                {
+                    sem_pistas.celulas[celula] = '.';
+                    ++tiradas;
+                }
+            }
+            sem_pistas.recalcular_mascaras();
+            tabuleiros.push_back(sem_pistas);
+        }
+    }
+    Solucao<> sequencial;
+    std::vector<std::size_t> esperadas;
+    for (const Tabuleiro &tabuleiro : tabuleiros)
+        esperadas.push_back(sequencial.contarSolucoes(tabuleiro, LIMITE_CONTAGEM));
+    Tabuleiro sem_solucao, vazio;
+    linha_para_tabuleiro(SEM_SOLUCAO, sem_solucao);
+    linha_para_tabuleiro(VAZIO, vazio);
+
+    bool tudo_certo = true;
+    std::cout << "\nMotor paralelo contra a busca sequencial (" << tabuleiros.size() << " tabuleiros, limite "
+              << LIMITE_CONTAGEM << ")\nThreads | Contagens iguais | Sem solução (us) | Vazio até o limite (us)\n";
+    for (unsigned threads : THREADS_CONFERIDAS)
+    {
+        SolucaoParalela paralela(threads);
+        std::size_t iguais = 0;
+        for (std::size_t i = 0; i < tabuleiros.size(); ++i)
+            iguais += paralela.contarSolucoes(tabuleiros[i], LIMITE_CONTAGEM) == esperadas[i];
+
+        auto inicio = std::chrono::steady_clock::now();
+        Tabuleiro tabuleiro = sem_solucao;
+        bool sem_solucao_certo = !paralela.resolverSudoku(tabuleiro) && paralela.contarSolucoes(sem_solucao) == 0;
+        auto meio = std::chrono::steady_clock::now();
+        bool vazio_certo = paralela.contarSolucoes(vazio, LIMITE_CONTAGEM) == LIMITE_CONTAGEM;
+        auto fim = std::chrono::steady_clock::now();
+
+        std::cout << threads << " | " << iguais << "/" << tabuleiros.size() << " | "
+                  << std::chrono::duration<double, std::micro>(meio - inicio).count()
+                  << (sem_solucao_certo ? "" : " (ERRO)") << " | "
+                  << std::chrono::duration<double, std::micro>(fim - meio).count()
+                  << (vazio_certo ? "" : " (ERRO)") << "\n";
+        tudo_certo = tudo_certo && iguais == tabuleiros.size() && sem_solucao_certo && vazio_certo;
+    }
+    if (!tudo_certo)
+        std::cerr << "O motor paralelo divergiu da busca sequencial\n";
+    return tudo_certo;
+}
+
+// Tabuleiros sem solução e de poucas pistas, em que quase nenhuma célula fica com só 2 candidatos: sem
+// chutar no dígito com menos lugares da unidade, a busca por célula passava de 20 milhões de nós (vários
+// segundos) no primeiro, contra milissegundos do Dancing Links
+const char *const CORPUS_SEM_SOLUCAO[] = {
+    ".....5.8....6.1.43..........1.5........1.6...3.......553.....61........4.........",
+    SEM_SOLUCAO,
+};
+
+// Nós (colocações) que a busca do motor de propagação pode gastar em cada um deles
+const std::size_t LIMITE_NOS_SEM_SOLUCAO = 100000;
+
+// Confere que todos os motores recusam cada tabuleiro de CORPUS_SEM_SOLUCAO, mostrando o tempo de cada um,
+// e que a busca do motor de propagação fica abaixo de LIMITE_NOS_SEM_SOLUCAO. Retorna false se algum falhar.
+bool conferir_sem_solucao()
+{
+    bool tudo_certo = true;
+    std::cout << "\nTabuleiros sem solução\nTabuleiro | Nós";
+    for (Motor motor : TODOS_MOTORES)
+        std::cout << " | " << nome_motor(motor) << " (us)";
+    std::cout << "\n";
+    for (const char *linha : CORPUS_SEM_SOLUCAO)
+    {
+        Tabuleiro original;
+        linha_para_tabuleiro(linha, original);
+
+        Solucao<RastreioContagem> contagem;
+        Tabuleiro tabuleiro = original;
+        bool certo = !contagem.resolverSudoku(tabuleiro) && contagem.rastreio().colocacoes <= LIMITE_NOS_SEM_SOLUCAO;
+        tudo_certo = tudo_certo && certo;
+        std::cout << linha << " | " << contagem.rastreio().colocacoes << (certo ? "" : " (ERRO)");
+
+        for (Motor motor : TODOS_MOTORES)
+        {
+            auto solucionador = std::make_unique<Solucionador>(motor);
+            tabuleiro = original;
+            auto inicio = std::chrono::steady_clock::now();
+            bool resolveu = solucionador->resolverSudoku(tabuleiro);
+            auto fim = std::chrono::steady_clock::now();
+            tudo_certo = tudo_certo && !resolveu;
+            std::cout << " | " << std::chrono::duration<double, std::micro>(fim - inicio).count()
+                      << (resolveu ? " (ERRO)" : "");
+        }
+        std::cout << "\n";
+    }
+    if (!tudo_certo)
+        std::cerr << "Algum motor resolveu um tabuleiro sem solução ou passou do limite de nós\n";
+    return tudo_certo;
+}
+
+// Grava os bytes num arquivo e diz se o LeitorArquivo o aceita
+bool leitor_aceita(const std::string &nome_arquivo, const std::vector<char> &bytes)
+{
+    {
+        std::ofstream arquivo(nome_arquivo, std::ios::binary | std::ios::trunc);
+        arquivo.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    LeitorArquivo leitor;
+    return leitor.abrir(nome_arquivo);
+}
+
+// Confere o formato binário: os tabuleiros dos corpora gravados e lidos de volta, e o mesmo arquivo com o
+// cabeçalho corrompido (quantidade enorme, quantidade maior do que cabe, posição do índice além do fim)
+// ou cortado (no meio do cabeçalho e no meio do índice), que o leitor precisa recusar.
+// Retorna false se algum caso falhar.
+bool conferir_arquivo_binario(const std::vector<Corpus> &corpora)
+{
+    std::string nome_arquivo = (std::filesystem::temp_directory_path() / "SudokuBenchmark_conferencia.sdk").string();
+    std::vector<Tabuleiro> tabuleiros;
+    {
+        EscritorArquivo escritor;
+        escritor.abrir(nome_arquivo, TipoArquivo::QuebraCabecas);
+        for (const Corpus &corpus : corpora)
+        {
+            for (const Tabuleiro &tabuleiro : corpus.tabuleiros)
+            {
+                if (escritor.escrever(tabuleiro))
+                    tabuleiros.push_back(tabuleiro);
+            }
+        }
+        escritor.fechar();
+    }
+
+    // Lê de volta o arquivo íntegro
+    bool tudo_certo = true;
+    {
+        LeitorArquivo leitor;
+        bool certo = leitor.abrir(nome_arquivo) && leitor.quantidade() == tabuleiros.size();
+        LeitorArquivo::Cursor cursor(leitor);
+        for (std::uint64_t i = 0; certo && i < tabuleiros.size(); ++i)
+        {
+            Tabuleiro lido;
+            certo = cursor.ler(i, lido) && lido.celulas == tabuleiros[i].celulas;
+        }
+        std::cout << "\nFormato binário (" << tabuleiros.size() << " tabuleiros)\nCaso | Resultado\n"
+                  << "íntegro, lido de volta | " << (certo ? "ok" : "ERRO") << "\n";
+        tudo_certo = certo;
+    }
+
+    std::vector<char> original;
+    {
+        std::ifstream arquivo(nome_arquivo, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+    }
+    if (original.size() < arquivo_binario::TAMANHO_CABECALHO)
+    {
+        std::cerr << "Não foi possível gravar o arquivo: " << nome_arquivo << "\n";
+        return false;
+    }
+    auto com_u64 = [&](std::size_t deslocamento, std::uint64_t valor)
+    {
+        std::vector<char> bytes = original;
+        arquivo_binario::escrever_le(reinterpret_cast<unsigned char *>(bytes.data()) + deslocamento, valor);
+        return bytes;
+    };
+    std::uint64_t posicao_indice = arquivo_binario::ler_le<std::uint64_t>(reinterpret_cast<const unsigned char *>(original.data()) + 24);
+    std::uint64_t cabem = (posicao_indice - arquivo_binario::TAMANHO_CABECALHO) / arquivo_binario::BYTES_MAPA;
+    const std::pair<const char *, std::vector<char>> corrompidos[] = {
+        {"quantidade 2^64-1", com_u64(8, ~std::uint64_t{0})},
+        {"quantidade maior do que cabe", com_u64(8, cabem + 1)},
+        {"índice além do fim", com_u64(24, original.size() + 1)},
+        {"cortado no cabeçalho", std::vector<char>(original.begin(), original.begin() + 20)},
+        {"cortado no índice", std::vector<char>(original.begin(), original.end() - 4)},
+    };
+    for (const auto &[caso, bytes] : corrompidos)
+    {
+        bool recusou = !leitor_aceita(nome_arquivo, bytes);
+        std::cout << caso << " | " << (recusou ? "recusado" : "ERRO: aceito") << "\n";
+        tudo_certo = tudo_certo && recusou;
+    }
+    std::remove(nome_arquivo.c_str());
+    if (!tudo_certo)
+        std::cerr << "O formato binário aceitou um arquivo corrompido ou não leu de volta o íntegro\n";
+    return tudo_certo;
+}
+
+// Grava todos os resultados em JSON, para comparar execuções de commits diferentes
+bool gravar_json(const std::string &nome_arquivo, const std::vector<Corpus> &corpora,
+                 const std::vector<std::vector<Medida>> &resultados)
+{
+    std::ofstream arquivo(nome_arquivo);
+    if (!arquivo.is_open())
+        return false;
+    arquivo << "{\n  \"amostras_minimas\": " << AMOSTRAS_MINIMAS << ",\n  \"corpora\": [\n";
+    for (std::size_t c = 0; c < corpora.size(); ++c)
+    {
+        const Corpus &corpus = corpora[c];
+        arquivo << "    {\n      \"nome\": \"" << corpus.nome << "\",\n"
+                << "      \"quebra_cabecas\": " << corpus.tabuleiros.size() << ",\n"
+                << "      \"nos_por_quebra_cabeca\": " << corpus.colocacoes << ",\n"
+                << "      \"retrocessos_por_quebra_cabeca\": " << corpus.retrocessos << ",\n"
+                << "      \"validacoes_por_s\": " << corpus.validacoes << ",\n"
+                << "      \"verificacoes_por_s\": " << corpus.verificacoes << ",\n"
+                << "      \"solucionadores\": [\n";
+        for (std::size_t i = 0; i < resultados[c].size(); ++i)
+        {
+            const Medida &m = resultados[c][i];
+            arquivo << "        {\"nome\": \"" << m.solucionador << "\", \"resolucoes\": " << m.resolucoes
+                    << ", \"resolvidos\": " << m.resolvidos << ", \"quebra_cabecas_por_s\": " << m.vazao
+                    << ", \"p50_us\": " << m.p50 << ", \"p99_us\": " << m.p99 << ", \"max_us\": " << m.maximo
+                    << ", \"alocacoes_por_resolucao\": " << m.alocacoes << "}"
+                    << (i + 1 < resultados[c].size() ? ",\n" : "\n");
+        }
+        arquivo << "      ]\n    }" << (c + 1 < corpora.size() ? ",\n" : "\n");
+    }
+    arquivo << "  ]\n}\n";
+    return static_cast<bool>(arquivo);
+}
+
+// SudokuBenchmark.exe [arquivo.txt] [--json resultados.json] [--gerados N]
+int main(int argc, char *argv[])
+{
+    std::setlocale(LC_ALL, "pt_BR.UTF-8"); // Configura acentuação no terminal
+
+    std::string caminho;
+    std::string nome_json;
+    std::size_t gerados = 30;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            nome_json = argv[++i];
+        else if (std::strcmp(argv[i], "--gerados") == 0 && i + 1 < argc)
+            gerados = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        else
+            caminho = argv[i];
+    }
+
+    // Carrega os corpora: só o arquivo informado (um quebra-cabeça por linha) ou os embutidos
+    std::vector<Corpus> corpora;
+    if (!caminho.empty())
+    {
+        EntradaQuebraCabecas entrada;
+        if (!entrada.abrir(caminho))
+        {
+            std::cerr << "Não foi possível abrir o arquivo: " << caminho << "\n";
+            return 1;
+        }
+        corpora.push_back(montar_corpus(caminho, entrada.linhas()));
+    }
+    else
+    {
+        corpora.push_back(montar_corpus("facil", CORPUS_FACIL));
+        corpora.push_back(montar_corpus("dificil", CORPUS_DIFICIL));
+        corpora.push_back(montar_corpus("17-pistas", CORPUS_17_PISTAS));
+        corpora.push_back(montar_corpus("adversario", CORPUS_ADVERSARIO));
+        corpora.push_back(montar_corpus("gerados", gerar_corpus(gerados)));
+    }
+
+    // Mede cada corpus com todos os solucionadores
+    std::vector<std::vector<Medida>> resultados;
+    for (Corpus &corpus : corpora)
+    {
+        contar_nos(corpus);
+        medir_validacao(corpus);
+        resultados.push_back(medir_corpus(corpus));
+        imprimir_corpus(corpus, resultados.back());
+    }
+
+    bool paralelo_certo = conferir_paralelo(corpora);
+    bool sem_solucao_certo = conferir_sem_solucao();
+    bool arquivo_certo = conferir_arquivo_binario(corpora);
+
+    if (!nome_json.empty())
+    {
+        if (!gravar_json(nome_json, corpora, resultados))
+        {
+            std::cerr << "Não foi possível salvar o arquivo: " << nome_json << "\n";
+            return 1;
+        }
+        std::cout << "\nResultados gravados em " << nome_json << "\n";
+    }
+    return paralelo_certo && sem_solucao_certo && arquivo_certo ? 0 : 1;
+}
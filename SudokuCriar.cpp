@@ -1,251 +1,530 @@
 // SudokuCriar.cpp
 
 #include <vector>    // Para usar listas (vetores) dinâmicos
-#include <array>     // Para usar arrays fixos, mais rápidos
-#include <bitset>    // Para representar conjuntos de bits (usado para controle rápido de valores)
 #include <iostream>  // Para entrada e saída (cin/cout)
-#include <cstdlib>   // Para funções como srand/rand
-#include <ctime>     // Para obter o horário atual (usado em srand)
-#include <fstream>   // Para salvar arquivos
-#include <algorithm> // Para usar funções de embaralhar (shuffle)
+#include <cstdlib>   // Para converter argumentos numéricos (atoi, atof)
+#include <algorithm> // Para std::min e std::max
 #include <random>    // Para gerar números aleatórios modernos
 #include <locale>    // Para configurar a linguagem/acentuação do terminal
 #include <string>    // Para usar strings
 
-// Função que retorna o índice da região 3x3 baseado na linha e coluna da célula
-constexpr std::size_t obter_regiao(std::size_t linha, std::size_t coluna) noexcept
-{
-    return (linha / 3) * 3 + coluna / 3;
-}
+#include <chrono>    // Para medir a taxa de geração
+#include <cstring>   // Para comparar os argumentos da linha de comando
+#include <cstdint>   // Para a semente de 64 bits
+#include <fstream>   // Para salvar os quebra-cabeças gerados em lote
+#include <type_traits> // Para saber em tempo de compilação se as estatísticas estão ligadas
 
-// Função que retorna a próxima linha ao percorrer o tabuleiro em ordem linha/coluna
-constexpr std::size_t proxima_linha(std::size_t linha, std::size_t coluna) noexcept
-{
-    return linha + (coluna + 1) / 9;
-}
-
-// Função que retorna a próxima coluna ao percorrer o tabuleiro em ordem linha/coluna
-constexpr std::size_t proxima_coluna(std::size_t coluna) noexcept
-{
-    return (coluna + 1) % 9;
-}
+#include "Tabuleiro.hpp"        // Tabuleiro plano de 81 células com máscaras
+#include "Solucao.hpp"          // Solucionador com propagação, usado para garantir solução única
+#include "Aleatorio.hpp"        // Gerador xoshiro256** rápido e reproduzível
+#include "Gerador.hpp"          // Geração de tabuleiros com solução única
+#include "ExecutorParalelo.hpp" // Threads com roubo de trabalho e escrita ordenada para o modo em lote
+#include "Classificador.hpp"    // Nota de dificuldade pelas técnicas humanas, para filtrar o lote
+#include "ArquivoBinario.hpp"   // Formato binário compacto para coleções grandes
+#include "Carregador.hpp"       // Leitura dos arquivos de texto a compactar
+#include "SudokuN.hpp"          // Tabuleiros 16x16 e 25x25
 
-// Função para imprimir o tabuleiro de Sudoku no terminal, com linhas e colunas separadoras
-void imprimir_tabuleiro(const std::vector<std::vector<char>> &tabuleiro)
+// Gera 'quantidade' quebra-cabeças de cada dificuldade e mostra a taxa de geração.
+// Cada quebra-cabeça é conferido com contarSolucoes (que para ao achar 2 soluções).
+void medir_taxa(int quantidade)
 {
-    std::cout << '\n'; // Linha em branco antes do tabuleiro
-    for (std::size_t linha = 0; linha < 9; ++linha)
+    GeradorRapido gerador(std::random_device{}());
+    Solucao<> solucao;
+    std::cout << "Dificuldade | Vazios pedidos | Vazios médios | Únicos | Quebra-cabeças/s\n";
+    for (int dificuldade = 1; dificuldade <= 3; ++dificuldade)
     {
-        // Imprime uma linha separadora a cada 3 linhas
-        if (linha % 3 == 0 && linha != 0)
+        int num_vazios = vazios_da_dificuldade(dificuldade);
+        long total_vazios = 0;
+        int unicos = 0;
+        auto inicio = std::chrono::steady_clock::now();
+        for (int i = 0; i < quantidade; ++i)
         {
-            std::cout << "------+-------+------\n";
+            Tabuleiro tabuleiro = gerar_tabuleiro_aleatorio(num_vazios, gerador, solucao);
+            total_vazios += contar_vazios(tabuleiro);
+            unicos += solucao.contarSolucoes(tabuleiro) == 1;
         }
-        for (std::size_t coluna = 0; coluna < 9; ++coluna)
-        {
-            // Imprime um separador vertical a cada 3 colunas
-            if (coluna % 3 == 0 && coluna != 0)
-            {
-                std::cout << "| ";
-            }
-            char c = tabuleiro[linha][coluna];
-            // Mostra ponto para célula vazia, ou o valor do dígito
-            if (c == '.')
-                std::cout << ". ";
-            else
-                std::cout << c << ' ';
-        }
-        std::cout << '\n'; // Nova linha após cada linha do tabuleiro
+        std::chrono::duration<double> tempo = std::chrono::steady_clock::now() - inicio;
+        std::cout << dificuldade << " | " << num_vazios << " | " << static_cast<double>(total_vazios) / quantidade
+                  << " | " << unicos << "/" << quantidade << " | " << quantidade / tempo.count() << "\n";
     }
-    std::cout << '\n'; // Linha em branco após o tabuleiro
 }
 
-// Classe responsável por resolver um Sudoku usando backtracking
-class Solucao
+// Quantos quebra-cabeças cada tarefa do modo em lote gera de uma vez
+const std::size_t TAMANHO_BLOCO = 16;
+
+// Quantos tabuleiros no máximo são gerados para achar um dentro da faixa de nota pedida
+const int TENTATIVAS_NOTA = 1000;
+
+// Faixa de nota aceita no modo em lote (veja Classificador.hpp); a padrão aceita tudo
+struct FaixaNota
 {
-public:
-    // Função principal que resolve o Sudoku
-    void resolverSudoku(std::vector<std::vector<char>> &tabuleiro) const noexcept
+    double minima = 0.0;
+    double maxima = 10.0;
+
+    bool aceita_tudo() const noexcept
     {
-        // Arrays de bits para marcar quais números já existem em cada linha, coluna e região
-        std::array<std::bitset<9>, 9> linha_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-        std::array<std::bitset<9>, 9> coluna_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-        std::array<std::bitset<9>, 9> regiao_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+        return minima <= 0.0 && maxima >= 10.0;
+    }
+};
+
+// Gera 'quantidade' quebra-cabeças em paralelo, um por linha (81 caracteres, '.' nas células vazias).
+// O texto de cada bloco vai, na ordem, para 'destino' (um fluxo de texto ou um EscritorArquivo); vazio descarta.
+// O quebra-cabeça i usa um gerador semeado com (semente, i): a saída é a mesma com qualquer número de threads.
+// Com uma faixa de nota, o quebra-cabeça i é o primeiro tabuleiro gerado nessa faixa; se nenhum cair nela
+// em TENTATIVAS_NOTA tentativas, a linha é pulada e contada em 'sem_nota'.
+// Com EstatisticasBusca, cada quebra-cabeça gera também uma linha JSON em saida_estatisticas com os
+// contadores das buscas feitas para garantir a unicidade, e a última linha traz o total do lote.
+// Devolve o tempo gasto em segundos.
+template <class Estatisticas>
+double gerar_lote(std::size_t quantidade, int num_vazios, std::uint64_t semente, unsigned num_threads,
+                  DestinoTexto destino, FaixaNota faixa, std::size_t &sem_nota, std::ostream *saida_estatisticas = nullptr)
+{
+    constexpr bool medir = std::is_same<Estatisticas, EstatisticasBusca>::value;
+    std::size_t num_blocos = (quantidade + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    std::vector<std::size_t> sem_nota_por_bloco(num_blocos, 0);
+    std::vector<EstatisticasBusca> estatisticas_por_bloco(medir ? num_blocos : 0);
+    EscritorOrdenado escritor(std::move(destino), num_blocos);
+    EscritorOrdenado escritor_estatisticas(medir ? saida_estatisticas : nullptr, num_blocos);
 
-        // Inicializa os bitsets com os valores já presentes no tabuleiro
-        for (std::size_t linha = 0; linha < 9; ++linha)
+    // Solucionador e classificador próprios de cada thread
+    std::vector<Solucao<RastreioNulo, Estatisticas>> solucoes(num_threads);
+    std::vector<Classificador> classificadores(faixa.aceita_tudo() ? 0 : num_threads);
+
+    auto inicio = std::chrono::steady_clock::now();
+    executar_blocos(num_blocos, num_threads, [&](std::size_t bloco, unsigned id)
+                    {
+        std::string texto;
+        std::string texto_estatisticas;
+        GeradorRapido gerador;
+        std::size_t fim = std::min(quantidade, (bloco + 1) * TAMANHO_BLOCO);
+        for (std::size_t i = bloco * TAMANHO_BLOCO; i < fim; ++i)
         {
-            for (std::size_t coluna = 0; coluna < 9; ++coluna)
+            gerador.semear(semente, i);
+            if constexpr (medir)
+                solucoes[id].estatisticas().zerar();
+            Tabuleiro tabuleiro = gerar_tabuleiro_aleatorio(num_vazios, gerador, solucoes[id]);
+            if (!faixa.aceita_tudo())
             {
-                char digito;
-                if ((digito = tabuleiro[linha][coluna]) != '.')
+                // Continua com o mesmo gerador até cair na faixa, para o resultado seguir reproduzível
+                int tentativa = 1;
+                double nota = classificadores[id].classificar(tabuleiro).nota;
+                while ((nota < faixa.minima || nota > faixa.maxima) && tentativa < TENTATIVAS_NOTA)
+                {
+                    tabuleiro = gerar_tabuleiro_aleatorio(num_vazios, gerador, solucoes[id]);
+                    nota = classificadores[id].classificar(tabuleiro).nota;
+                    ++tentativa;
+                }
+                if (nota < faixa.minima || nota > faixa.maxima)
                 {
-                    std::size_t idx_digito = digito - '1'; // Converte caractere '1'-'9' para 0-8
-                    linha_contem[linha].set(idx_digito);
-                    coluna_contem[coluna].set(idx_digito);
-                    std::size_t regiao = obter_regiao(linha, coluna);
-                    regiao_contem[regiao].set(idx_digito);
+                    ++sem_nota_por_bloco[bloco];
+                    continue;
                 }
             }
-        }
-        // Chama o solucionador recursivo a partir da posição (0,0)
-        resolver(tabuleiro, 0, 0, linha_contem, coluna_contem, regiao_contem);
-    }
-
-private:
-    // Função que encontra a próxima célula vazia a partir de uma posição
-    static constexpr std::pair<std::size_t, std::size_t> proxima_posicao_vazia(std::vector<std::vector<char>> &tabuleiro, std::size_t linha, std::size_t coluna) noexcept
-    {
-        while (linha != 9) // Percorre até o final do tabuleiro
-        {
-            if (tabuleiro[linha][coluna] == '.')
+            escrever_linha(tabuleiro, texto);
+            if constexpr (medir)
             {
-                return {linha, coluna}; // Retorna a posição da célula vazia
+                const EstatisticasBusca &estatisticas = solucoes[id].estatisticas();
+                texto_estatisticas += "{\"indice\": " + std::to_string(i) +
+                                      ", \"vazios\": " + std::to_string(contar_vazios(tabuleiro)) + ", ";
+                estatisticas.escrever_campos_json(texto_estatisticas);
+                texto_estatisticas += "}\n";
+                estatisticas_por_bloco[bloco].somar(estatisticas);
             }
-            linha = proxima_linha(linha, coluna);
-            coluna = proxima_coluna(coluna);
         }
-        return {9, 0}; // Não encontrou, retorna posição "final"
+        escritor.entregar(bloco, std::move(texto));
+        escritor_estatisticas.entregar(bloco, std::move(texto_estatisticas)); });
+    auto fim = std::chrono::steady_clock::now();
+    escritor.finalizar();
+    escritor_estatisticas.finalizar();
+
+    sem_nota = 0;
+    for (std::size_t s : sem_nota_por_bloco)
+        sem_nota += s;
+
+    // Total do lote: soma dos contadores e dos tempos, maior profundidade
+    if (medir && saida_estatisticas)
+    {
+        EstatisticasBusca total;
+        for (const EstatisticasBusca &estatisticas : estatisticas_por_bloco)
+            total.somar(estatisticas);
+        std::string texto = "{\"total\": true, \"quebra_cabecas\": " + std::to_string(quantidade - sem_nota) + ", ";
+        total.escrever_campos_json(texto);
+        texto += "}\n";
+        *saida_estatisticas << texto << std::flush;
     }
+    return std::chrono::duration<double>(fim - inicio).count();
+}
 
-    // Função recursiva de backtracking que preenche o tabuleiro
-    static bool resolver(std::vector<std::vector<char>> &tabuleiro, std::size_t linha_inicio, std::size_t coluna_inicio,
-                         std::array<std::bitset<9>, 9> &linha_contem,
-                         std::array<std::bitset<9>, 9> &coluna_contem,
-                         std::array<std::bitset<9>, 9> &regiao_contem) noexcept
+// Gera 'quantidade' quebra-cabeças LADO x LADO (16x16 ou 25x25) em paralelo, um por linha, como gerar_lote:
+// o quebra-cabeça i usa um gerador semeado com (semente, i), então a saída não depende do número de threads.
+// Cada quebra-cabeça desses custa de milissegundos a segundos, então cada bloco tem um só.
+// Devolve o tempo gasto em segundos e, em total_vazios, a soma das células vazias alcançadas.
+template <std::size_t Caixa>
+double gerar_lote_n(std::size_t quantidade, std::size_t num_vazios, std::uint64_t semente, unsigned num_threads,
+                    DestinoTexto destino, std::size_t &total_vazios)
+{
+    EscritorOrdenado escritor(std::move(destino), quantidade);
+    std::vector<SolucaoN<Caixa>> solucoes(num_threads);
+    std::vector<std::size_t> vazios(quantidade, 0);
+
+    auto inicio = std::chrono::steady_clock::now();
+    executar_blocos(quantidade, num_threads, [&](std::size_t i, unsigned id)
+                    {
+        GeradorRapido gerador(semente, i);
+        TabuleiroN<Caixa> tabuleiro = gerar_tabuleiro_aleatorio(num_vazios, gerador, solucoes[id]);
+        vazios[i] = contar_vazios(tabuleiro);
+        std::string texto;
+        escrever_linha(tabuleiro, texto);
+        escritor.entregar(i, std::move(texto)); });
+    auto fim = std::chrono::steady_clock::now();
+    escritor.finalizar();
+
+    total_vazios = 0;
+    for (std::size_t v : vazios)
+        total_vazios += v;
+    return std::chrono::duration<double>(fim - inicio).count();
+}
+
+// Gera o mesmo lote com 1, 2, 4, ... threads até max_threads e mostra quebra-cabeças/s de cada um
+void medir_escalonamento(std::size_t quantidade, int num_vazios, std::uint64_t semente, unsigned max_threads,
+                         FaixaNota faixa)
+{
+    std::cerr << "Threads | Tempo (s) | Quebra-cabeças/s | Aceleração\n";
+    double tempo_base = 0;
+    for (unsigned threads = 1;; threads = std::min(threads * 2, max_threads))
     {
-        // Encontra a próxima célula vazia
-        auto [linha, coluna] = proxima_posicao_vazia(tabuleiro, linha_inicio, coluna_inicio);
+        std::size_t sem_nota;
+        double segundos = gerar_lote<EstatisticasNulas>(quantidade, num_vazios, semente, threads, nullptr, faixa, sem_nota);
+        if (threads == 1)
+            tempo_base = segundos;
+        std::cerr << threads << " | " << segundos << " | " << quantidade / segundos << " | "
+                  << tempo_base / segundos << "x\n";
+        if (threads == max_threads)
+            break;
+    }
+}
+
+// Modo em lote: SudokuCriar.exe --gerar N [--tamanho 9|16|25] [--dificuldade D] [--nota MIN MAX] [--semente S]
+//                                         [--threads T] [--saida arquivo [--binario]] [--escalonamento]
+//                                         [--estatisticas arquivo.jsonl]
+// Com --binario a saída usa o formato compacto de ArquivoBinario.hpp em vez de uma linha de texto por quebra-cabeça.
+// Nos tamanhos 16 e 25 não há nota, estatísticas, binário nem escalonamento, que são do motor 9x9.
+int executar_gerar(int argc, char *argv[])
+{
+    std::size_t quantidade = 0;
+    int dificuldade = 2;
+    int lado = 9;
+    std::uint64_t semente = std::random_device{}();
+    unsigned num_threads = threads_disponiveis();
+    const char *nome_saida = nullptr;
+    bool binario = false;
+    bool escalonamento = false;
+    FaixaNota faixa;
+    const char *nome_estatisticas = nullptr;
 
-        // Se percorreu todo o tabuleiro, a solução está completa
-        if (linha == 9)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--gerar") == 0 && i + 1 < argc)
+            quantidade = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--dificuldade") == 0 && i + 1 < argc)
+            dificuldade = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--tamanho") == 0 && i + 1 < argc)
+            lado = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--nota") == 0 && i + 2 < argc)
         {
-            return true;
+            faixa.minima = std::atof(argv[++i]);
+            faixa.maxima = std::atof(argv[++i]);
         }
-
-        // Calcula o índice da região 3x3
-        std::size_t regiao = obter_regiao(linha, coluna);
-        // Gera um bitset que indica quais dígitos já estão presentes na linha, coluna ou região
-        std::bitset<9> contem = linha_contem[linha] | coluna_contem[coluna] | regiao_contem[regiao];
-        // Se todos os números já estão presentes, não é possível preencher essa célula
-        if (contem.all())
+        else if (std::strcmp(argv[i], "--semente") == 0 && i + 1 < argc)
+            semente = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            num_threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "--saida") == 0 && i + 1 < argc)
+            nome_saida = argv[++i];
+        else if (std::strcmp(argv[i], "--binario") == 0)
+            binario = true;
+        else if (std::strcmp(argv[i], "--escalonamento") == 0)
+            escalonamento = true;
+        else if (std::strcmp(argv[i], "--estatisticas") == 0 && i + 1 < argc)
+            nome_estatisticas = argv[++i];
+        else
         {
-            return false;
+            std::cerr << "Argumento desconhecido: " << argv[i] << "\n";
+            return 1;
         }
+    }
+    if (quantidade == 0)
+    {
+        std::cerr << "Informe quantos quebra-cabeças gerar: --gerar N\n";
+        return 1;
+    }
+    if (binario && !nome_saida)
+    {
+        // O cabeçalho é regravado no final, então o formato binário precisa de um arquivo de verdade
+        std::cerr << "O formato binário precisa de um arquivo: --saida arquivo.sdk --binario\n";
+        return 1;
+    }
+    if (lado != 9 && lado != 16 && lado != 25)
+    {
+        std::cerr << "Tamanho não suportado: " << lado << " (use 9, 16 ou 25)\n";
+        return 1;
+    }
+    if (lado != 9 && (!faixa.aceita_tudo() || nome_estatisticas || binario || escalonamento))
+    {
+        std::cerr << "--nota, --estatisticas, --binario e --escalonamento só existem no 9x9\n";
+        return 1;
+    }
+    int num_vazios = vazios_da_dificuldade(dificuldade);
+
+    if (escalonamento)
+    {
+        medir_escalonamento(quantidade, num_vazios, semente, num_threads, faixa);
+        return 0;
+    }
 
-        // Vetor com os índices dos dígitos possíveis (0-8, que representam '1'-'9')
-        std::vector<std::size_t> digitos{0, 1, 2, 3, 4, 5, 6, 7, 8};
-        // Embaralha a ordem dos dígitos para variar a geração do tabuleiro
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(digitos.begin(), digitos.end(), g);
+    std::ofstream arquivo;
+    EscritorArquivo arquivo_binario;
+    if (nome_saida)
+    {
+        bool aberto = binario ? arquivo_binario.abrir(nome_saida, TipoArquivo::QuebraCabecas)
+                              : (arquivo.open(nome_saida), arquivo.is_open());
+        if (!aberto)
+        {
+            std::cerr << "Não foi possível abrir " << nome_saida << "\n";
+            return 1;
+        }
+    }
+    std::ostream &saida = nome_saida ? static_cast<std::ostream &>(arquivo) : std::cout;
+    // No binário, a thread do escritor ordenado converte cada bloco de linhas em registros compactos
+    DestinoTexto destino = [&](const std::string &texto)
+    {
+        if (binario)
+            arquivo_binario.escrever_texto(texto);
+        else
+            saida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+    };
 
-        // Tenta todos os dígitos possíveis na célula
-        for (std::size_t idx_digito : digitos)
+    // Estatísticas em JSON, uma linha por quebra-cabeça ("-" manda para o stderr)
+    std::ofstream arquivo_estatisticas;
+    std::ostream *saida_estatisticas = nullptr;
+    if (nome_estatisticas)
+    {
+        if (std::strcmp(nome_estatisticas, "-") == 0)
+            saida_estatisticas = &std::cerr;
+        else
         {
-            if (!contem[idx_digito]) // Se esse dígito ainda não foi usado
+            arquivo_estatisticas.open(nome_estatisticas);
+            if (!arquivo_estatisticas.is_open())
             {
-                tabuleiro[linha][coluna] = static_cast<char>(idx_digito + '1'); // Preenche a célula
-                linha_contem[linha].set(idx_digito);                            // Marca na linha
-                coluna_contem[coluna].set(idx_digito);                          // Marca na coluna
-                regiao_contem[regiao].set(idx_digito);                          // Marca na região
-                // Chama recursivamente para próxima célula
-                if (resolver(tabuleiro, linha, coluna, linha_contem, coluna_contem, regiao_contem))
-                {
-                    return true; // Se resolveu, retorna true
-                }
-                // Se não resolveu, desfaz (backtracking)
-                linha_contem[linha].reset(idx_digito);
-                coluna_contem[coluna].reset(idx_digito);
-                regiao_contem[regiao].reset(idx_digito);
+                std::cerr << "Não foi possível abrir " << nome_estatisticas << "\n";
+                return 1;
             }
+            saida_estatisticas = &arquivo_estatisticas;
         }
-        // Nenhum dígito funcionou, desfaz o preenchimento e retorna false
-        tabuleiro[linha][coluna] = '.';
-        return false;
     }
-};
 
-// Função para gerar um tabuleiro de Sudoku completo e depois remover células
-std::vector<std::vector<char>> gerar_tabuleiro_aleatorio(int num_vazios)
+    if (lado != 9)
+    {
+        std::size_t total_vazios;
+        double segundos = lado == 16 ? gerar_lote_n<4>(quantidade, vazios_da_dificuldade_n<4>(dificuldade), semente,
+                                                       num_threads, destino, total_vazios)
+                                     : gerar_lote_n<5>(quantidade, vazios_da_dificuldade_n<5>(dificuldade), semente,
+                                                       num_threads, destino, total_vazios);
+        saida.flush();
+        std::cerr << "Gerados: " << quantidade << " de " << lado << "x" << lado << " (semente " << semente << ", "
+                  << num_threads << " threads, " << static_cast<double>(total_vazios) / quantidade << " vazios em média)\n"
+                  << "Tempo: " << segundos << " s (" << quantidade / segundos << " quebra-cabeças/s)\n";
+        return 0;
+    }
+
+    std::size_t sem_nota;
+    double segundos = saida_estatisticas
+                          ? gerar_lote<EstatisticasBusca>(quantidade, num_vazios, semente, num_threads, destino, faixa,
+                                                          sem_nota, saida_estatisticas)
+                          : gerar_lote<EstatisticasNulas>(quantidade, num_vazios, semente, num_threads, destino, faixa,
+                                                          sem_nota);
+    saida.flush();
+    if (binario && !arquivo_binario.fechar())
+    {
+        std::cerr << "Não foi possível gravar " << nome_saida << "\n";
+        return 1;
+    }
+    std::cerr << "Gerados: " << quantidade - sem_nota << " (semente " << semente << ", " << num_threads << " threads)\n"
+              << "Tempo: " << segundos << " s (" << (quantidade - sem_nota) / segundos << " quebra-cabeças/s)\n";
+    if (sem_nota)
+    {
+        std::cerr << sem_nota << " quebra-cabeças não chegaram à faixa de nota em " << TENTATIVAS_NOTA
+                  << " tentativas; tente outra dificuldade\n";
+        return 1;
+    }
+    return 0;
+}
+
+// Tamanho do arquivo em bytes, para mostrar o ganho da conversão
+std::uintmax_t tamanho_arquivo(const char *nome_arquivo)
 {
-    // Inicializa o tabuleiro vazio
-    std::vector<std::vector<char>> tabuleiro(9, std::vector<char>(9, '.'));
+    std::ifstream arquivo(nome_arquivo, std::ios::binary | std::ios::ate);
+    return arquivo.is_open() ? static_cast<std::uintmax_t>(arquivo.tellg()) : 0;
+}
 
-    // Preenche todo o tabuleiro com uma solução válida
-    Solucao().resolverSudoku(tabuleiro);
+// Converte texto (uma linha de 81 caracteres por tabuleiro) para o formato binário:
+// SudokuCriar.exe --compactar entrada.txt saida.sdk [--solucoes]
+// Com --solucoes as linhas precisam ser soluções completas, que ocupam 19 bytes cada
+int executar_compactar(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "Uso: --compactar entrada.txt saida.sdk [--solucoes]\n";
+        return 1;
+    }
+    TipoArquivo tipo = (argc > 4 && std::strcmp(argv[4], "--solucoes") == 0) ? TipoArquivo::Solucoes
+                                                                            : TipoArquivo::QuebraCabecas;
+    EntradaQuebraCabecas entrada;
+    if (!entrada.abrir(argv[2]))
+    {
+        std::cerr << "Não foi possível abrir " << argv[2] << "\n";
+        return 1;
+    }
+    EscritorArquivo arquivo;
+    if (!arquivo.abrir(argv[3], tipo))
+    {
+        std::cerr << "Não foi possível abrir " << argv[3] << "\n";
+        return 1;
+    }
 
-    // Remove aleatoriamente 'num_vazios' células do tabuleiro, tornando-as vazias
-    std::srand(std::time(nullptr));
-    while (num_vazios > 0)
+    // Linhas que não cabem no formato (tamanho ou caractere inválido, solução incompleta) ficam de fora
+    std::size_t rejeitadas = 0;
+    Tabuleiro tabuleiro;
+    for (std::string_view linha : entrada.linhas())
     {
-        int linha = std::rand() % 9;
-        int coluna = std::rand() % 9;
-        if (tabuleiro[linha][coluna] != '.')
+        if (!linha_para_tabuleiro(linha, tabuleiro) || !arquivo.escrever(tabuleiro))
         {
-            tabuleiro[linha][coluna] = '.';
-            --num_vazios;
+            if (rejeitadas++ < 10)
+                std::cerr << "Linha ignorada: " << linha << "\n";
         }
     }
-    // Retorna o tabuleiro com células removidas
-    return tabuleiro;
+    if (!arquivo.fechar())
+    {
+        std::cerr << "Não foi possível gravar " << argv[3] << "\n";
+        return 1;
+    }
+    std::uintmax_t antes = tamanho_arquivo(argv[2]);
+    std::uintmax_t depois = tamanho_arquivo(argv[3]);
+    std::cerr << "Tabuleiros: " << arquivo.registros() << " | Ignorados: " << rejeitadas << " | Bytes: " << antes
+              << " -> " << depois;
+    if (antes && depois)
+        std::cerr << " (" << static_cast<double>(antes) / static_cast<double>(depois) << "x menor)";
+    std::cerr << "\n";
+    return rejeitadas ? 1 : 0;
 }
 
-// Função para salvar o tabuleiro de Sudoku em um arquivo texto
-void salvar_tabuleiro(const std::vector<std::vector<char>> &tabuleiro, const std::string &nome_arquivo)
+// Converte o formato binário de volta para texto: SudokuCriar.exe --descompactar entrada.sdk saida.txt
+// Com "-" como saída, as linhas vão para a saída padrão
+int executar_descompactar(int argc, char *argv[])
 {
-    std::ofstream arquivo(nome_arquivo);
-    if (!arquivo.is_open())
+    if (argc < 4)
+    {
+        std::cerr << "Uso: --descompactar entrada.sdk saida.txt\n";
+        return 1;
+    }
+    LeitorArquivo leitor;
+    if (!leitor.abrir(argv[2]))
     {
-        std::cout << "Não foi possível salvar o arquivo: " << nome_arquivo << "\n";
-        return;
+        std::cerr << "Não foi possível abrir " << argv[2] << " como arquivo binário de Sudoku\n";
+        return 1;
     }
-    // Escreve o tabuleiro no arquivo, linha por linha
-    for (const auto &linha : tabuleiro)
+    std::ofstream arquivo;
+    if (std::strcmp(argv[3], "-") != 0)
     {
-        for (const auto &celula : linha)
+        arquivo.open(argv[3], std::ios::binary);
+        if (!arquivo.is_open())
         {
-            arquivo << celula;
+            std::cerr << "Não foi possível abrir " << argv[3] << "\n";
+            return 1;
         }
-        arquivo << "\n";
     }
-    arquivo.close();
+    std::ostream &saida = arquivo.is_open() ? static_cast<std::ostream &>(arquivo) : std::cout;
+
+    // Lê em sequência, escrevendo um grupo do índice por vez
+    LeitorArquivo::Cursor cursor(leitor);
+    Tabuleiro tabuleiro;
+    std::string texto;
+    for (std::uint64_t i = 0; i < leitor.quantidade(); ++i)
+    {
+        if (!cursor.ler(i, tabuleiro))
+        {
+            std::cerr << "Registro " << i << " corrompido em " << argv[2] << "\n";
+            return 1;
+        }
+        escrever_linha(tabuleiro, texto);
+        if ((i + 1) % leitor.registros_por_grupo() == 0)
+        {
+            saida << texto;
+            texto.clear();
+        }
+    }
+    saida << texto << std::flush;
+    std::cerr << "Tabuleiros: " << leitor.quantidade() << "\n";
+    return saida ? 0 : 1;
 }
 
 // Função principal do programa
-int main()
+int main(int argc, char *argv[])
 {
     std::setlocale(LC_ALL, "pt_BR.UTF-8"); // Configura acentuação no terminal
 
+    // Mede a taxa de geração: SudokuCriar.exe --taxa [quantidade por dificuldade]
+    if (argc > 1 && std::strcmp(argv[1], "--taxa") == 0)
+    {
+        medir_taxa(argc > 2 ? std::max(1, std::atoi(argv[2])) : 100);
+        return 0;
+    }
+
+    // Geração em lote com várias threads
+    if (argc > 1 && std::strcmp(argv[1], "--gerar") == 0)
+    {
+        return executar_gerar(argc, argv);
+    }
+
+    // Conversão entre texto e o formato binário compacto
+    if (argc > 1 && std::strcmp(argv[1], "--compactar") == 0)
+    {
+        return executar_compactar(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--descompactar") == 0)
+    {
+        return executar_descompactar(argc, argv);
+    }
+
     int dificuldade;
     std::cout << "Escolha o nível de dificuldade (1 - Fácil, 2 - Médio, 3 - Difícil): ";
     std::cin >> dificuldade; // Lê a dificuldade desejada
 
-    int num_vazios;
     // Define quantas células vazias de acordo com a dificuldade escolhida
-    switch (dificuldade)
+    if (dificuldade < 1 || dificuldade > 3)
     {
-    case 1:
-        num_vazios = 20; // Fácil
-        break;
-    case 2:
-        num_vazios = 40; // Médio
-        break;
-    case 3:
-        num_vazios = 60; // Difícil
-        break;
-    default:
         std::cout << "Escolha inválida. Usando dificuldade Fácil.\n";
-        num_vazios = 30; // Padrão caso digite errado
-        break;
     }
+    int num_vazios = vazios_da_dificuldade(dificuldade);
 
     // Gera o tabuleiro de Sudoku aleatório com o número de células vazias escolhido
-    std::vector<std::vector<char>> tabuleiro = gerar_tabuleiro_aleatorio(num_vazios);
+    GeradorRapido gerador(std::random_device{}());
+    Solucao<> solucao;
+    Tabuleiro tabuleiro = gerar_tabuleiro_aleatorio(num_vazios, gerador, solucao);
+
+    int vazios = contar_vazios(tabuleiro);
+    if (vazios < num_vazios)
+    {
+        std::cout << "Só foi possível esvaziar " << vazios << " células mantendo a solução única.\n";
+    }
 
     std::cout << "Sudoku gerado:\n";
     imprimir_tabuleiro(tabuleiro); // Exibe o tabuleiro no terminal
 
+    // Mostra a dificuldade real, pela técnica mais difícil necessária para resolver
+    Classificacao classificacao = Classificador().classificar(tabuleiro);
+    std::cout << "Nota: " << classificacao.nota << " (técnica mais difícil: " << nome_tecnica(classificacao.mais_dificil) << ")\n";
+
     std::string nome_arquivo;
     std::cout << "Digite o nome do arquivo para salvar o Sudoku (exemplo: facil.txt): ";
     std::cin >> nome_arquivo; // Lê o nome do arquivo
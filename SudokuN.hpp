@@ -0,0 +1,645 @@
+// SudokuN.hpp
+
+#pragma once
+
+#include <array>       // Para as células, máscaras e tabelas de tamanho fixo
+#include <cstdint>     // Para os tipos de máscara e de índice de cada tamanho
+#include <iostream>    // Para imprimir o tabuleiro
+#include <string>      // Para as mensagens de validação
+#include <string_view> // Para converter linhas sem copiá-las
+#include <type_traits> // Para escolher os tipos em tempo de compilação
+
+#include "Aleatorio.hpp" // Gerador xoshiro256** rápido e reproduzível
+#include "Gerador.hpp"   // Proporção de células vazias de cada dificuldade
+
+// Sudoku de qualquer tamanho com regiões Caixa x Caixa: Caixa = 3 é o 9x9, 4 o 16x16 e 5 o 25x25.
+// Tudo que depende do tamanho (laços, tabelas, tipo das máscaras) é fixado em tempo de compilação,
+// então cada tamanho ganha o seu próprio código, sem nenhum tamanho lido em tempo de execução.
+// O 9x9 do resto do programa continua usando Tabuleiro/Solucao, que são ajustados para ele.
+
+// Símbolos dos valores 1..25 no texto; '.' ou '0' é vazio. Até 9 é igual ao formato 9x9
+constexpr char SIMBOLOS_N[] = "123456789ABCDEFGHIJKLMNOP";
+
+// Tamanhos e tipos de cada Caixa
+template <std::size_t Caixa>
+struct GeometriaN
+{
+    static_assert(Caixa >= 2 && Caixa <= 5, "Tamanhos suportados: 4x4, 9x9, 16x16 e 25x25");
+
+    static constexpr std::size_t LADO = Caixa * Caixa;
+    static constexpr std::size_t CELULAS = LADO * LADO;
+    static constexpr std::size_t NUM_UNIDADES = 3 * LADO;
+
+    // Máscara de valores (bit v = valor v + 1): 16 bits até 16x16, 32 bits no 25x25
+    using Mascara = std::conditional_t<(LADO <= 16), std::uint16_t, std::uint32_t>;
+    // Índice de célula: 1 byte até 16x16 (256 células), 2 bytes no 25x25
+    using Celula = std::conditional_t<(CELULAS <= 256), std::uint8_t, std::uint16_t>;
+
+    static constexpr Mascara TODOS = static_cast<Mascara>((std::uint64_t{1} << LADO) - 1);
+    static constexpr std::uint8_t VAZIO = 0;
+    static constexpr std::uint8_t INVALIDO = 0xFF;
+};
+
+// Tabelas calculadas em tempo de compilação: células de cada unidade e linha/coluna/região de cada célula
+template <std::size_t Caixa>
+struct TabelasN
+{
+    using G = GeometriaN<Caixa>;
+
+    // Unidades 0..LADO-1 são as linhas, depois as colunas e por último as regiões
+    std::array<std::array<typename G::Celula, G::LADO>, G::NUM_UNIDADES> unidades{};
+    std::array<std::uint8_t, G::CELULAS> linha{};
+    std::array<std::uint8_t, G::CELULAS> coluna{};
+    std::array<std::uint8_t, G::CELULAS> regiao{};
+};
+
+template <std::size_t Caixa>
+constexpr TabelasN<Caixa> gerar_tabelas_n() noexcept
+{
+    using G = GeometriaN<Caixa>;
+    TabelasN<Caixa> tabelas{};
+    for (std::size_t i = 0; i < G::LADO; ++i)
+    {
+        for (std::size_t j = 0; j < G::LADO; ++j)
+        {
+            std::size_t celula_regiao = (i / Caixa * Caixa + j / Caixa) * G::LADO + i % Caixa * Caixa + j % Caixa;
+            tabelas.unidades[i][j] = static_cast<typename G::Celula>(i * G::LADO + j);              // Linha i
+            tabelas.unidades[G::LADO + i][j] = static_cast<typename G::Celula>(j * G::LADO + i);    // Coluna i
+            tabelas.unidades[2 * G::LADO + i][j] = static_cast<typename G::Celula>(celula_regiao); // Região i
+
+            std::size_t celula = i * G::LADO + j;
+            tabelas.linha[celula] = static_cast<std::uint8_t>(i);
+            tabelas.coluna[celula] = static_cast<std::uint8_t>(j);
+            tabelas.regiao[celula] = static_cast<std::uint8_t>(i / Caixa * Caixa + j / Caixa);
+        }
+    }
+    return tabelas;
+}
+
+template <std::size_t Caixa>
+inline constexpr TabelasN<Caixa> TABELAS_N = gerar_tabelas_n<Caixa>();
+
+// Tabuleiro LADO x LADO: um byte por célula (0 vazio, v + 1 para o valor v) e as máscaras
+// dos valores já usados em cada linha, coluna e região, como no Tabuleiro 9x9
+template <std::size_t Caixa>
+struct TabuleiroN
+{
+    using G = GeometriaN<Caixa>;
+    using MascaraN = typename G::Mascara;
+
+    std::array<std::uint8_t, G::CELULAS> celulas;
+    std::array<MascaraN, G::LADO> linha_contem;
+    std::array<MascaraN, G::LADO> coluna_contem;
+    std::array<MascaraN, G::LADO> regiao_contem;
+
+    TabuleiroN() noexcept
+    {
+        limpar();
+    }
+
+    void limpar() noexcept
+    {
+        celulas.fill(G::VAZIO);
+        linha_contem.fill(0);
+        coluna_contem.fill(0);
+        regiao_contem.fill(0);
+    }
+
+    // Recalcula as máscaras a partir das células (ignora células com caractere inválido)
+    void recalcular_mascaras() noexcept
+    {
+        linha_contem.fill(0);
+        coluna_contem.fill(0);
+        regiao_contem.fill(0);
+        for (std::size_t celula = 0; celula < G::CELULAS; ++celula)
+        {
+            std::uint8_t valor = celulas[celula];
+            if (valor == G::VAZIO || valor == G::INVALIDO)
+                continue;
+            MascaraN bit = static_cast<MascaraN>(MascaraN{1} << (valor - 1));
+            linha_contem[TABELAS_N<Caixa>.linha[celula]] |= bit;
+            coluna_contem[TABELAS_N<Caixa>.coluna[celula]] |= bit;
+            regiao_contem[TABELAS_N<Caixa>.regiao[celula]] |= bit;
+        }
+    }
+
+    // Valores já usados na unidade (linhas, depois colunas, depois regiões)
+    MascaraN contem_unidade(std::size_t unidade) const noexcept
+    {
+        if (unidade < G::LADO)
+            return linha_contem[unidade];
+        if (unidade < 2 * G::LADO)
+            return coluna_contem[unidade - G::LADO];
+        return regiao_contem[unidade - 2 * G::LADO];
+    }
+
+    // Valores que ainda podem ir na célula
+    MascaraN candidatos(std::size_t celula) const noexcept
+    {
+        return static_cast<MascaraN>(~(linha_contem[TABELAS_N<Caixa>.linha[celula]] |
+                                      coluna_contem[TABELAS_N<Caixa>.coluna[celula]] |
+                                      regiao_contem[TABELAS_N<Caixa>.regiao[celula]]) &
+                                    G::TODOS);
+    }
+
+    // Coloca o valor (índice 0..LADO-1) na célula e marca nas máscaras
+    void colocar(std::size_t celula, std::size_t idx_valor) noexcept
+    {
+        MascaraN bit = static_cast<MascaraN>(MascaraN{1} << idx_valor);
+        celulas[celula] = static_cast<std::uint8_t>(idx_valor + 1);
+        linha_contem[TABELAS_N<Caixa>.linha[celula]] |= bit;
+        coluna_contem[TABELAS_N<Caixa>.coluna[celula]] |= bit;
+        regiao_contem[TABELAS_N<Caixa>.regiao[celula]] |= bit;
+    }
+
+    // Esvazia a célula e desmarca o valor dela nas máscaras
+    void remover(std::size_t celula) noexcept
+    {
+        MascaraN bit = static_cast<MascaraN>(~(MascaraN{1} << (celulas[celula] - 1)));
+        celulas[celula] = G::VAZIO;
+        linha_contem[TABELAS_N<Caixa>.linha[celula]] &= bit;
+        coluna_contem[TABELAS_N<Caixa>.coluna[celula]] &= bit;
+        regiao_contem[TABELAS_N<Caixa>.regiao[celula]] &= bit;
+    }
+};
+
+// Converte uma linha de LADO x LADO caracteres em tabuleiro; retorna false se o tamanho for inválido.
+// Caracteres que não são símbolos do tamanho viram células inválidas, apontadas por validar_tabuleiro_n.
+template <std::size_t Caixa>
+bool linha_para_tabuleiro(std::string_view linha, TabuleiroN<Caixa> &tabuleiro) noexcept
+{
+    using G = GeometriaN<Caixa>;
+    if (linha.size() != G::CELULAS)
+        return false;
+    for (std::size_t celula = 0; celula < G::CELULAS; ++celula)
+    {
+        char c = linha[celula];
+        std::uint8_t valor = G::INVALIDO;
+        if (c == '.' || c == '0')
+            valor = G::VAZIO;
+        else if (c >= '1' && c <= '9')
+            valor = static_cast<std::uint8_t>(c - '0');
+        else if (c >= 'A' && c <= 'Z')
+            valor = static_cast<std::uint8_t>(c - 'A' + 10);
+        else if (c >= 'a' && c <= 'z')
+            valor = static_cast<std::uint8_t>(c - 'a' + 10);
+        tabuleiro.celulas[celula] = (valor == G::VAZIO || valor <= G::LADO) ? valor : G::INVALIDO;
+    }
+    return true;
+}
+
+// Acrescenta o tabuleiro em uma única linha de LADO x LADO caracteres
+template <std::size_t Caixa>
+void escrever_linha(const TabuleiroN<Caixa> &tabuleiro, std::string &saida)
+{
+    for (std::uint8_t valor : tabuleiro.celulas)
+        saida += valor == GeometriaN<Caixa>::VAZIO ? '.' : SIMBOLOS_N[valor - 1];
+    saida += '\n';
+}
+
+// Imprime o tabuleiro com divisórias entre as regiões
+template <std::size_t Caixa>
+void imprimir_tabuleiro(const TabuleiroN<Caixa> &tabuleiro)
+{
+    using G = GeometriaN<Caixa>;
+    std::string texto = "\n";
+    for (std::size_t linha = 0; linha < G::LADO; ++linha)
+    {
+        if (linha % Caixa == 0 && linha != 0)
+        {
+            for (std::size_t regiao = 0; regiao < Caixa; ++regiao)
+                texto += std::string(2 * Caixa + (regiao != 0), '-') + (regiao + 1 < Caixa ? "+" : "");
+            texto += '\n';
+        }
+        for (std::size_t coluna = 0; coluna < G::LADO; ++coluna)
+        {
+            if (coluna % Caixa == 0 && coluna != 0)
+                texto += "| ";
+            std::uint8_t valor = tabuleiro.celulas[linha * G::LADO + coluna];
+            texto += valor == G::VAZIO ? '.' : SIMBOLOS_N[valor - 1];
+            texto += ' ';
+        }
+        texto += '\n';
+    }
+    std::cout << texto << '\n';
+}
+
+// Valida o tabuleiro antes de resolver, com as mesmas mensagens e a mesma ordem de validar_tabuleiro:
+// repetição nas linhas, nas colunas, nas regiões e, por último, caractere inválido
+template <std::size_t Caixa>
+std::string validar_tabuleiro_n(const TabuleiroN<Caixa> &tabuleiro)
+{
+    using G = GeometriaN<Caixa>;
+    using MascaraN = typename G::Mascara;
+    for (std::size_t unidade = 0; unidade < G::NUM_UNIDADES; ++unidade)
+    {
+        MascaraN vistos = 0;
+        for (typename G::Celula celula : TABELAS_N<Caixa>.unidades[unidade])
+        {
+            std::uint8_t valor = tabuleiro.celulas[celula];
+            if (valor == G::VAZIO || valor == G::INVALIDO)
+                continue;
+            MascaraN bit = static_cast<MascaraN>(MascaraN{1} << (valor - 1));
+            if (!(vistos & bit))
+            {
+                vistos |= bit;
+                continue;
+            }
+            std::size_t indice = unidade % G::LADO;
+            if (unidade < G::LADO)
+                return "Número repetido na linha " + std::to_string(indice + 1) + ".";
+            if (unidade < 2 * G::LADO)
+                return "Número repetido na coluna " + std::to_string(indice + 1) + ".";
+            return "Número repetido no bloco " + std::to_string(Caixa) + "x" + std::to_string(Caixa) +
+                   " começando em linha " + std::to_string(indice / Caixa * Caixa + 1) + ", coluna " +
+                   std::to_string(indice % Caixa * Caixa + 1) + ".";
+        }
+    }
+    for (std::size_t celula = 0; celula < G::CELULAS; ++celula)
+        if (tabuleiro.celulas[celula] == G::INVALIDO)
+            return "Caractere inválido na posição linha " + std::to_string(celula / G::LADO + 1) +
+                   ", coluna " + std::to_string(celula % G::LADO + 1) + ".";
+    return "";
+}
+
+// Solucionador N x N com a mesma estratégia do Solucao 9x9: propagação de singles (nus e escondidos)
+// e chute na célula com menos candidatos (MRV) ou, se ela tiver mais de 2, no valor com menos lugares
+// numa unidade (veja escolher), desfazendo pela trilha de jogadas.
+// Nos tamanhos maiores uma busca pode explodir, então há um limite opcional de nós por busca.
+template <std::size_t Caixa>
+class SolucaoN
+{
+public:
+    using G = GeometriaN<Caixa>;
+    using MascaraN = typename G::Mascara;
+
+    // Limite de nós de cada busca (0 = sem limite). Se estourar, a busca desiste e esgotou() fica true
+    void limitar_nos(std::uint64_t limite) noexcept
+    {
+        limite_nos = limite;
+    }
+
+    bool esgotou() const noexcept
+    {
+        return esgotado;
+    }
+
+    // Com um gerador, os candidatos de cada chute são tentados em ordem aleatória (para sortear soluções)
+    void sortear_com(GeradorRapido *gerador_usado) noexcept
+    {
+        gerador = gerador_usado;
+    }
+
+    // Resolve o tabuleiro; retorna false se não tem solução (ou se o limite de nós estourou)
+    bool resolverSudoku(TabuleiroN<Caixa> &tabuleiro)
+    {
+        tabuleiro.recalcular_mascaras();
+        iniciar_busca();
+        Trilha trilha;
+        return resolver(tabuleiro, trilha);
+    }
+
+    std::string validarTabuleiro(const TabuleiroN<Caixa> &tabuleiro) const
+    {
+        return validar_tabuleiro_n(tabuleiro);
+    }
+
+    // Conta as soluções, parando ao chegar no limite (2 basta para saber se é única)
+    std::size_t contarSolucoes(TabuleiroN<Caixa> tabuleiro, std::size_t limite = 2)
+    {
+        tabuleiro.recalcular_mascaras();
+        iniciar_busca();
+        Trilha trilha;
+        std::size_t encontradas = 0;
+        contar(tabuleiro, trilha, limite, encontradas);
+        return encontradas;
+    }
+
+private:
+    // Pilha das células preenchidas, usada para desfazer a propagação ao retroceder
+    struct Trilha
+    {
+        std::array<typename G::Celula, G::CELULAS> celulas;
+        std::size_t topo = 0;
+    };
+
+    std::uint64_t limite_nos = 0;
+    std::uint64_t nos = 0;
+    bool esgotado = false;
+    GeradorRapido *gerador = nullptr;
+
+    void iniciar_busca() noexcept
+    {
+        nos = 0;
+        esgotado = false;
+    }
+
+    // Conta um nó; retorna false se o limite estourou
+    bool entrar_no() noexcept
+    {
+        if (limite_nos && ++nos > limite_nos)
+            esgotado = true;
+        return !esgotado;
+    }
+
+    static void colocar(TabuleiroN<Caixa> &tabuleiro, Trilha &trilha, std::size_t celula, std::size_t idx_valor) noexcept
+    {
+        tabuleiro.colocar(celula, idx_valor);
+        trilha.celulas[trilha.topo++] = static_cast<typename G::Celula>(celula);
+    }
+
+    static void desfazer_ate(TabuleiroN<Caixa> &tabuleiro, Trilha &trilha, std::size_t marca) noexcept
+    {
+        while (trilha.topo > marca)
+            tabuleiro.remover(trilha.celulas[--trilha.topo]);
+    }
+
+    // Propaga os singles até não haver mais nenhum; retorna false se encontrar uma contradição
+    static bool propagar(TabuleiroN<Caixa> &tabuleiro, Trilha &trilha) noexcept
+    {
+        bool mudou = true;
+        while (mudou)
+        {
+            mudou = false;
+
+            // Naked singles: células vazias com um único candidato
+            for (std::size_t celula = 0; celula < G::CELULAS; ++celula)
+            {
+                if (tabuleiro.celulas[celula] != G::VAZIO)
+                    continue;
+                MascaraN candidatos = tabuleiro.candidatos(celula);
+                if (candidatos == 0)
+                    return false;
+                if ((candidatos & (candidatos - 1)) == 0)
+                {
+                    colocar(tabuleiro, trilha, celula, static_cast<std::size_t>(__builtin_ctz(candidatos)));
+                    mudou = true;
+                }
+            }
+
+            // Hidden singles: valores que só cabem em uma célula da unidade
+            for (std::size_t unidade = 0; unidade < G::NUM_UNIDADES; ++unidade)
+            {
+                MascaraN faltam = static_cast<MascaraN>(~tabuleiro.contem_unidade(unidade) & G::TODOS);
+                if (faltam == 0)
+                    continue;
+
+                MascaraN uma_vez = 0, duas_vezes = 0;
+#pragma GCC unroll 25
+                for (std::size_t i = 0; i < G::LADO; ++i)
+                {
+                    std::size_t celula = TABELAS_N<Caixa>.unidades[unidade][i];
+                    // Célula preenchida não tem candidatos; a máscara zero evita um desvio no laço desenrolado
+                    MascaraN candidatos = tabuleiro.celulas[celula] == G::VAZIO ? tabuleiro.candidatos(celula) : MascaraN{0};
+                    duas_vezes |= uma_vez & candidatos;
+                    uma_vez |= candidatos;
+                }
+                if ((uma_vez & faltam) != faltam)
+                    return false;
+
+                MascaraN unicos = static_cast<MascaraN>(uma_vez & ~duas_vezes);
+                while (unicos)
+                {
+                    std::size_t idx_valor = static_cast<std::size_t>(__builtin_ctz(unicos));
+                    unicos &= static_cast<MascaraN>(unicos - 1);
+
+                    // Procura a célula que aceita o valor (pode ter sumido por uma jogada anterior)
+                    std::size_t destino = G::CELULAS;
+                    for (typename G::Celula celula : TABELAS_N<Caixa>.unidades[unidade])
+                    {
+                        if (tabuleiro.celulas[celula] == G::VAZIO && (tabuleiro.candidatos(celula) >> idx_valor & 1u))
+                        {
+                            destino = celula;
+                            break;
+                        }
+                    }
+                    if (destino == G::CELULAS)
+                        return false;
+                    colocar(tabuleiro, trilha, destino, idx_valor);
+                    mudou = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Uma alternativa de um chute: colocar o valor na célula
+    struct Jogada
+    {
+        typename G::Celula celula;
+        std::uint8_t idx_valor;
+    };
+
+    // Escolhe onde ramificar e preenche as alternativas; retorna quantas são (0 se o tabuleiro está cheio).
+    // Começa pela célula com menos candidatos (MRV); se ela tiver mais de 2, procura também o valor que
+    // cabe em menos células de alguma unidade (como a coluna de menor tamanho do Dancing Links).
+    // Nos tamanhos grandes quase nunca há célula com 2 candidatos, mas quase sempre há um valor
+    // com 2 lugares numa unidade, e chutar nele corta a busca muitas vezes.
+    std::size_t escolher(const TabuleiroN<Caixa> &tabuleiro, std::array<Jogada, G::LADO> &jogadas)
+    {
+        std::size_t melhor = G::CELULAS;
+        int menor = static_cast<int>(G::LADO) + 1;
+        for (std::size_t celula = 0; celula < G::CELULAS && menor > 2; ++celula)
+        {
+            if (tabuleiro.celulas[celula] != G::VAZIO)
+                continue;
+            int quantidade = __builtin_popcount(tabuleiro.candidatos(celula));
+            if (quantidade < menor)
+            {
+                menor = quantidade;
+                melhor = celula;
+            }
+        }
+        if (melhor == G::CELULAS)
+            return 0;
+
+        // Depois da propagação todo valor que falta cabe em pelo menos 2 células da unidade
+        std::size_t melhor_unidade = G::NUM_UNIDADES, melhor_valor = 0;
+        for (std::size_t unidade = 0; unidade < G::NUM_UNIDADES && menor > 2; ++unidade)
+        {
+            std::array<std::uint8_t, G::LADO> lugares{};
+            for (typename G::Celula celula : TABELAS_N<Caixa>.unidades[unidade])
+            {
+                if (tabuleiro.celulas[celula] != G::VAZIO)
+                    continue;
+                MascaraN candidatos = tabuleiro.candidatos(celula);
+                while (candidatos)
+                {
+                    ++lugares[static_cast<std::size_t>(__builtin_ctz(candidatos))];
+                    candidatos &= static_cast<MascaraN>(candidatos - 1);
+                }
+            }
+            for (std::size_t idx_valor = 0; idx_valor < G::LADO; ++idx_valor)
+            {
+                if (lugares[idx_valor] != 0 && lugares[idx_valor] < menor)
+                {
+                    menor = lugares[idx_valor];
+                    melhor_unidade = unidade;
+                    melhor_valor = idx_valor;
+                }
+            }
+        }
+        if (melhor_unidade != G::NUM_UNIDADES)
+        {
+            std::size_t quantidade = 0;
+            for (typename G::Celula celula : TABELAS_N<Caixa>.unidades[melhor_unidade])
+                if (tabuleiro.celulas[celula] == G::VAZIO && (tabuleiro.candidatos(celula) >> melhor_valor & 1u))
+                    jogadas[quantidade++] = Jogada{celula, static_cast<std::uint8_t>(melhor_valor)};
+            return sortear(jogadas, quantidade);
+        }
+
+        std::size_t quantidade = 0;
+        MascaraN candidatos = tabuleiro.candidatos(melhor);
+        while (candidatos)
+        {
+            jogadas[quantidade++] = Jogada{static_cast<typename G::Celula>(melhor),
+                                           static_cast<std::uint8_t>(__builtin_ctz(candidatos))};
+            candidatos &= static_cast<MascaraN>(candidatos - 1);
+        }
+        return sortear(jogadas, quantidade);
+    }
+
+    // Com um gerador, embaralha as alternativas (para sortear soluções completas)
+    std::size_t sortear(std::array<Jogada, G::LADO> &jogadas, std::size_t quantidade) noexcept
+    {
+        if (gerador)
+            embaralhar(jogadas.data(), quantidade, *gerador);
+        return quantidade;
+    }
+
+    bool resolver(TabuleiroN<Caixa> &tabuleiro, Trilha &trilha)
+    {
+        if (!entrar_no())
+            return false;
+        std::size_t marca = trilha.topo;
+        if (!propagar(tabuleiro, trilha))
+        {
+            desfazer_ate(tabuleiro, trilha, marca);
+            return false;
+        }
+
+        std::array<Jogada, G::LADO> jogadas;
+        std::size_t quantidade = escolher(tabuleiro, jogadas);
+        if (quantidade == 0)
+            return true; // Tabuleiro cheio: solução encontrada
+
+        for (std::size_t i = 0; i < quantidade && !esgotado; ++i)
+        {
+            colocar(tabuleiro, trilha, jogadas[i].celula, jogadas[i].idx_valor);
+            if (resolver(tabuleiro, trilha))
+                return true;
+            desfazer_ate(tabuleiro, trilha, trilha.topo - 1);
+        }
+        desfazer_ate(tabuleiro, trilha, marca);
+        return false;
+    }
+
+    // Como resolver, mas percorre todos os ramos somando as soluções até chegar ao limite.
+    // As alternativas de cada chute são disjuntas (células ou valores diferentes), então nenhuma solução conta duas vezes.
+    void contar(TabuleiroN<Caixa> &tabuleiro, Trilha &trilha, std::size_t limite, std::size_t &encontradas)
+    {
+        if (!entrar_no())
+            return;
+        std::size_t marca = trilha.topo;
+        if (propagar(tabuleiro, trilha))
+        {
+            std::array<Jogada, G::LADO> jogadas;
+            std::size_t quantidade = escolher(tabuleiro, jogadas);
+            if (quantidade == 0)
+                ++encontradas;
+            for (std::size_t i = 0; i < quantidade && encontradas < limite && !esgotado; ++i)
+            {
+                colocar(tabuleiro, trilha, jogadas[i].celula, jogadas[i].idx_valor);
+                contar(tabuleiro, trilha, limite, encontradas);
+                desfazer_ate(tabuleiro, trilha, trilha.topo - 1);
+            }
+        }
+        desfazer_ate(tabuleiro, trilha, marca);
+    }
+};
+
+// Limites de nós do gerador N x N: para sortear a solução completa (com reinício se estourar)
+// e para cada teste de unicidade ou de resolução (se estourar, a pista fica)
+template <std::size_t Caixa>
+constexpr std::uint64_t NOS_SOLUCAO_N = 40 * GeometriaN<Caixa>::CELULAS;
+template <std::size_t Caixa>
+constexpr std::uint64_t NOS_UNICIDADE_N = 4 * GeometriaN<Caixa>::CELULAS;
+
+// Células vazias pedidas em cada dificuldade: a mesma proporção do 9x9 (veja vazios_da_dificuldade)
+template <std::size_t Caixa>
+std::size_t vazios_da_dificuldade_n(int dificuldade)
+{
+    return static_cast<std::size_t>(vazios_da_dificuldade(dificuldade)) * GeometriaN<Caixa>::CELULAS / 81;
+}
+
+// Verifica se, depois de esvaziar a célula que tinha o valor, a solução continua única: procura
+// alguma solução com outro valor nessa célula, como continua_unica do 9x9
+template <std::size_t Caixa>
+bool continua_unica(SolucaoN<Caixa> &solucao, const TabuleiroN<Caixa> &tabuleiro, std::size_t celula, std::size_t idx_valor)
+{
+    using MascaraN = typename GeometriaN<Caixa>::Mascara;
+    MascaraN outros = static_cast<MascaraN>(tabuleiro.candidatos(celula) & ~(MascaraN{1} << idx_valor));
+    while (outros)
+    {
+        std::size_t outro = static_cast<std::size_t>(__builtin_ctz(outros));
+        outros &= static_cast<MascaraN>(outros - 1);
+        TabuleiroN<Caixa> copia = tabuleiro;
+        copia.colocar(celula, outro);
+        if (solucao.resolverSudoku(copia) || solucao.esgotou())
+            return false; // Achou outra solução, ou não deu para garantir que não existe
+    }
+    return true;
+}
+
+// Sorteia uma solução completa e esvazia células em ordem aleatória enquanto a solução continua única.
+// Como no 9x9, o resultado depende só do estado do gerador. Nos tamanhos maiores pode parar antes
+// de 'num_vazios' quando os testes estouram o limite de nós.
+template <std::size_t Caixa>
+TabuleiroN<Caixa> gerar_tabuleiro_aleatorio(std::size_t num_vazios, GeradorRapido &gerador, SolucaoN<Caixa> &solucao)
+{
+    using G = GeometriaN<Caixa>;
+    TabuleiroN<Caixa> tabuleiro;
+
+    // Solução completa: busca com candidatos embaralhados, recomeçando se passar do limite de nós
+    solucao.sortear_com(&gerador);
+    solucao.limitar_nos(NOS_SOLUCAO_N<Caixa>);
+    do
+    {
+        tabuleiro.limpar();
+    } while (!solucao.resolverSudoku(tabuleiro));
+    solucao.sortear_com(nullptr);
+
+    // Esvazia as células em ordem aleatória, desfazendo as remoções que quebram a unicidade
+    solucao.limitar_nos(NOS_UNICIDADE_N<Caixa>);
+    std::array<typename G::Celula, G::CELULAS> ordem;
+    for (std::size_t i = 0; i < G::CELULAS; ++i)
+        ordem[i] = static_cast<typename G::Celula>(i);
+    embaralhar(ordem.data(), ordem.size(), gerador);
+
+    std::size_t vazios = 0;
+    for (std::size_t i = 0; i < G::CELULAS && vazios < num_vazios; ++i)
+    {
+        std::size_t celula = ordem[i];
+        std::size_t idx_valor = static_cast<std::size_t>(tabuleiro.celulas[celula] - 1);
+        tabuleiro.remover(celula);
+        // Além de continuar única, a solução precisa ser achada dentro do limite de nós:
+        // assim o quebra-cabeça gerado nunca cai na cauda longa da busca
+        TabuleiroN<Caixa> copia = tabuleiro;
+        if (continua_unica(solucao, tabuleiro, celula, idx_valor) && solucao.resolverSudoku(copia))
+            ++vazios;
+        else
+            tabuleiro.colocar(celula, idx_valor);
+    }
+    solucao.limitar_nos(0);
+    return tabuleiro;
+}
+
+// Conta as células vazias do tabuleiro
+template <std::size_t Caixa>
+std::size_t contar_vazios(const TabuleiroN<Caixa> &tabuleiro)
+{
+    std::size_t vazios = 0;
+    for (std::uint8_t valor : tabuleiro.celulas)
+        vazios += (valor == GeometriaN<Caixa>::VAZIO);
+    return vazios;
+}
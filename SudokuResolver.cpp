@@ -1,262 +1,1063 @@
 // SudokuResolver.cpp
 
-#include <vector>   // Para usar vetores dinâmicos (listas 2D para o tabuleiro)
-#include <array>    // Para arrays fixos de tamanho conhecido (bitsets por linha, coluna, região)
-#include <bitset>   // Para representar conjunto de 9 bits (usado para controle rápido de valores)
+#include <vector>   // Para as listas de linhas e blocos do modo em lote
+#include <array>    // Para os tabuleiros de um bloco do motor intercalado
 #include <iostream> // Para entrada/saída de dados (cin/cout)
-#include <fstream>  // Para ler tabuleiros de arquivos
+#include <fstream>  // Para gravar as estatísticas em arquivo
 #include <chrono>   // Para medir o tempo de execução
 #include <locale>   // Para configurar a acentuação do terminal
 #include <string>   // Para manipulação de strings
-#include <set>      // Para validação de repetições (linhas, colunas, blocos)
+#include <string_view> // Para as linhas do lote, que apontam direto para o arquivo
+#include <cstring>  // Para comparar os argumentos da linha de comando
+#include <cstdlib>  // Para converter argumentos numéricos (atoi)
+#include <algorithm> // Para std::min e std::max
+#include <cstdio>   // Para formatar a nota com uma casa decimal (snprintf)
+#include <sstream>  // Para separar os comandos do modo de jogo
+#include <limits>   // Para a fatia do serviço sem limite de nós
+#include <memory>   // Para o estado da busca de cada pedido em fatias
 
-// Função que retorna o índice da região 3x3 para uma posição no tabuleiro
-constexpr std::size_t obter_regiao(std::size_t linha, std::size_t coluna) noexcept
+#include "Tabuleiro.hpp"        // Tabuleiro plano de 81 células com máscaras
+#include "Solucao.hpp"          // Validação e backtracking
+#include "Motores.hpp"          // Escolha do motor de resolução em tempo de execução
+#include "ExecutorParalelo.hpp" // Threads com roubo de trabalho para o modo em lote
+#include "Carregador.hpp"       // Leitura dos arquivos de lote mapeados na memória, sem cópia
+#include "Classificador.hpp"    // Nota de dificuldade pelas técnicas humanas necessárias
+#include "ArquivoBinario.hpp"   // Lotes no formato binário compacto
+#include "SudokuN.hpp"          // Tabuleiros 16x16 e 25x25
+#include "CacheSolucoes.hpp"    // Cache de soluções pela forma canônica
+#include "Servico.hpp"          // Serviço de longa duração pela entrada padrão ou socket local
+#include "Jogo.hpp"             // Estado incremental de uma partida (jogadas, conflitos, dicas)
+
+// Abre o arquivo (mapeado na memória) ou a entrada padrão se o caminho for "-"; retorna false se não abrir
+bool ler_entrada(const std::string &caminho, EntradaQuebraCabecas &entrada)
+{
+    if (!entrada.abrir(caminho))
+    {
+        std::cerr << "Não foi possível abrir o arquivo: " << caminho << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Mostra no stderr o problema na linha de comando e o uso do modo; retorna 1 para o main encerrar com erro
+int erro_de_uso(const std::string &problema, const char *uso)
+{
+    std::cerr << problema << "\nUso: " << uso << "\n";
+    return 1;
+}
+
+// true se o argumento tem cara de opção ("--algo"); "-" sozinho é a entrada padrão, não uma opção
+bool e_opcao(const char *argumento) noexcept
 {
-    return (linha / 3) * 3 + coluna / 3;
+    return std::strncmp(argumento, "--", 2) == 0;
 }
 
-// Imprime o tabuleiro com divisórias de bloco, espaço antes e depois
-void imprimir_tabuleiro(const std::vector<std::vector<char>> &tabuleiro)
+// Quebra-cabeças de um lote em texto: as linhas apontam direto para o arquivo mapeado
+class FonteTexto
 {
-    std::cout << '\n'; // Linha em branco antes do tabuleiro
-    for (std::size_t linha = 0; linha < 9; ++linha)
+public:
+    explicit FonteTexto(const std::vector<std::string_view> &linhas_lidas) : linhas(linhas_lidas) {}
+
+    std::size_t tamanho() const noexcept
+    {
+        return linhas.size();
+    }
+
+    std::string_view linha(std::size_t indice, unsigned, std::string &) const noexcept
     {
-        // Linha divisória entre blocos horizontais
-        if (linha % 3 == 0 && linha != 0)
+        return linhas[indice];
+    }
+
+private:
+    const std::vector<std::string_view> &linhas;
+};
+
+// Quebra-cabeças de um lote no formato binário: cada thread decodifica com o seu cursor.
+// Os blocos do lote começam em múltiplos de TAMANHO_BLOCO, que coincidem com os grupos do índice,
+// então cada bloco é lido em sequência a partir do seu grupo.
+class FonteBinaria
+{
+public:
+    FonteBinaria(const LeitorArquivo &leitor_usado, unsigned max_threads)
+        : leitor(leitor_usado), cursores(max_threads, LeitorArquivo::Cursor(leitor_usado)), tabuleiros(max_threads) {}
+
+    std::size_t tamanho() const noexcept
+    {
+        return static_cast<std::size_t>(leitor.quantidade());
+    }
+
+    // Devolve o registro como linha de texto no buffer da thread
+    std::string_view linha(std::size_t indice, unsigned id, std::string &buffer)
+    {
+        buffer.clear();
+        if (!cursores[id].ler(indice, tabuleiros[id]))
+            return buffer = "Registro corrompido no arquivo binário";
+        buffer.append(tabuleiros[id].celulas.begin(), tabuleiros[id].celulas.end());
+        return buffer;
+    }
+
+private:
+    const LeitorArquivo &leitor;
+    std::vector<LeitorArquivo::Cursor> cursores;
+    std::vector<Tabuleiro> tabuleiros;
+};
+
+// Abre o lote e chama 'executar' com a fonte certa: arquivos com a assinatura do formato binário
+// são lidos registro a registro, o resto (e a entrada padrão) como texto. Retorna o que 'executar' retornar.
+template <class Funcao>
+int com_fonte(const std::string &caminho, unsigned max_threads, Funcao executar)
+{
+    if (caminho != "-" && LeitorArquivo::e_binario(caminho))
+    {
+        LeitorArquivo leitor;
+        if (!leitor.abrir(caminho))
+        {
+            std::cerr << "Arquivo binário inválido: " << caminho << "\n";
+            return 1;
+        }
+        FonteBinaria fonte(leitor, max_threads);
+        return executar(fonte);
+    }
+    EntradaQuebraCabecas entrada;
+    if (!ler_entrada(caminho, entrada))
+        return 1;
+    FonteTexto fonte(entrada.linhas());
+    return executar(fonte);
+}
+
+// Resolve uma linha do lote e acrescenta o resultado em saida; retorna true se resolveu.
+// O resolvedor é um Solucionador ou um Solucao (por exemplo, com estatísticas) com um Tabuleiro,
+// ou um SolucaoN com um TabuleiroN do mesmo tamanho.
+template <class Resolvedor, class TabuleiroUsado>
+bool resolver_linha(Resolvedor &solucionador, std::string_view linha,
+                    TabuleiroUsado &tabuleiro, std::string &saida)
+{
+    std::string motivo;
+    if (!linha_para_tabuleiro(linha, tabuleiro))
+    {
+        motivo = "Linha com tamanho diferente de " + std::to_string(tabuleiro.celulas.size()) + " caracteres.";
+    }
+    else if ((motivo = solucionador.validarTabuleiro(tabuleiro)).empty() &&
+             !solucionador.resolverSudoku(tabuleiro))
+    {
+        motivo = "Não existe solução para o tabuleiro de Sudoku informado!";
+    }
+
+    if (!motivo.empty())
+    {
+        // Falhas repetem a entrada seguida do motivo
+        saida += linha;
+        saida += " ; ";
+        saida += motivo;
+        saida += '\n';
+        return false;
+    }
+    escrever_linha(tabuleiro, saida);
+    return true;
+}
+
+// Uma fatia de tempo de um pedido do serviço, com o mesmo resultado de resolver_linha. Na primeira fatia
+// valida o tabuleiro e prepara a busca iterativa; nas seguintes, retoma de onde parou. Retorna false se a
+// fatia acabou antes do fim da busca (o pedido volta para a fila com o estado).
+bool resolver_fatia(Solucao<> &solucionador, Pedido &pedido, std::chrono::microseconds fatia, std::string &saida)
+{
+    std::string_view linha = pedido.tabuleiro;
+    std::string motivo;
+    if (!pedido.estado)
+    {
+        Tabuleiro tabuleiro;
+        if (!linha_para_tabuleiro(linha, tabuleiro))
+            motivo = "Linha com tamanho diferente de 81 caracteres.";
+        else if ((motivo = solucionador.validarTabuleiro(tabuleiro)).empty())
         {
-            std::cout << "------+-------+------\n";
+            pedido.estado = std::make_unique<EstadoBusca>();
+            solucionador.iniciar(*pedido.estado, tabuleiro);
         }
-        for (std::size_t coluna = 0; coluna < 9; ++coluna)
+    }
+    if (motivo.empty())
+    {
+        ResultadoBusca resultado = solucionador.continuar(*pedido.estado, std::numeric_limits<std::uint64_t>::max(), fatia);
+        if (resultado == ResultadoBusca::Esgotado)
+            return false;
+        if (resultado == ResultadoBusca::Resolvido)
         {
-            // Linha divisória entre blocos verticais
-            if (coluna % 3 == 0 && coluna != 0)
-            {
-                std::cout << "| ";
-            }
-            char c = tabuleiro[linha][coluna];
-            // Mostra "." para vazio, ou o valor para preenchido
-            if (c == '.')
-                std::cout << ". ";
-            else
-                std::cout << c << ' ';
+            escrever_linha(pedido.estado->tabuleiro, saida);
+            return true;
         }
-        std::cout << '\n'; // Fim da linha do tabuleiro
+        motivo = "Não existe solução para o tabuleiro de Sudoku informado!";
     }
-    std::cout << '\n'; // Linha em branco após o tabuleiro
+    saida += linha;
+    saida += " ; ";
+    saida += motivo;
+    saida += '\n';
+    return true;
 }
 
-// Função que valida o tabuleiro antes de resolver (repetição ou caractere inválido)
-std::string validar_tabuleiro(const std::vector<std::vector<char>> &tabuleiro)
+// Quantidade de quebra-cabeças por bloco de trabalho do modo em lote
+constexpr std::size_t TAMANHO_BLOCO = 64;
+
+// Resolve as linhas [inicio, fim) da fonte de uma vez com Solucionador::resolverVarios (o motor intercalado
+// põe 16 para andar juntos), com a mesma saída que resolver_linha daria para cada uma; retorna quantas
+// foram resolvidas. As linhas originais são copiadas porque a fonte binária reaproveita o buffer.
+template <class Fonte>
+std::size_t resolver_bloco(Solucionador &solucionador, Fonte &fonte, std::size_t inicio, std::size_t fim,
+                           unsigned id, std::string &saida)
 {
-    // Verifica repetição nas linhas
-    for (int i = 0; i < 9; ++i)
+    std::array<Tabuleiro, TAMANHO_BLOCO> lote;
+    std::array<bool, TAMANHO_BLOCO> resolvidos{};
+    std::array<std::size_t, TAMANHO_BLOCO> posicoes; // Posição de cada linha no lote (TAMANHO_BLOCO se inválida)
+    std::array<std::string, TAMANHO_BLOCO> motivos;
+    std::array<std::size_t, TAMANHO_BLOCO + 1> limites{}; // Linha k em originais: [limites[k], limites[k + 1])
+    std::string originais;
+    std::string buffer;
+    std::size_t n = 0;
+    for (std::size_t i = inicio; i < fim; ++i)
+    {
+        std::size_t k = i - inicio;
+        std::string_view linha = fonte.linha(i, id, buffer);
+        originais += linha;
+        limites[k + 1] = originais.size();
+        if (!linha_para_tabuleiro(linha, lote[n]))
+            motivos[k] = "Linha com tamanho diferente de 81 caracteres.";
+        else
+            motivos[k] = solucionador.validarTabuleiro(lote[n]);
+        posicoes[k] = motivos[k].empty() ? n++ : TAMANHO_BLOCO;
+    }
+    solucionador.resolverVarios(lote.data(), resolvidos.data(), n);
+
+    std::size_t total_resolvidos = 0;
+    for (std::size_t k = 0; k < fim - inicio; ++k)
     {
-        std::set<char> s;
-        for (int j = 0; j < 9; ++j)
+        if (posicoes[k] != TAMANHO_BLOCO && resolvidos[posicoes[k]])
         {
-            char c = tabuleiro[i][j];
-            if (c != '.')
+            escrever_linha(lote[posicoes[k]], saida);
+            ++total_resolvidos;
+            continue;
+        }
+        saida.append(originais, limites[k], limites[k + 1] - limites[k]);
+        saida += " ; ";
+        saida += motivos[k].empty() ? "Não existe solução para o tabuleiro de Sudoku informado!" : motivos[k];
+        saida += '\n';
+    }
+    return total_resolvidos;
+}
+
+// Um Solucionador por thread, cada um com threads_motor threads no motor paralelo (os solucionadores
+// não podem ser copiados, então cada um é criado no lugar)
+std::vector<Solucionador> criar_solucionadores(std::size_t quantidade, Motor motor, unsigned threads_motor)
+{
+    std::vector<Solucionador> solucionadores;
+    solucionadores.reserve(quantidade);
+    for (std::size_t i = 0; i < quantidade; ++i)
+        solucionadores.emplace_back(motor, threads_motor);
+    return solucionadores;
+}
+
+// O mesmo, com o cache de soluções na frente de cada Solucionador
+std::vector<ResolvedorComCache<Solucionador>> criar_com_cache(std::size_t quantidade, Motor motor, unsigned threads_motor,
+                                                              CacheSolucoes &cache)
+{
+    std::vector<ResolvedorComCache<Solucionador>> resolvedores;
+    resolvedores.reserve(quantidade);
+    for (std::size_t i = 0; i < quantidade; ++i)
+        resolvedores.emplace_back(Solucionador(motor, threads_motor), cache);
+    return resolvedores;
+}
+
+// Resultado agregado de uma execução em lote
+struct ResultadoLote
+{
+    std::size_t total = 0;
+    std::size_t resolvidos = 0;
+    double segundos = 0.0;
+    EstatisticasCache cache; // Só preenchido quando o lote usa o cache de soluções
+};
+
+// Solucionador usado quando as estatísticas são pedidas (só o motor de propagação tem contadores)
+using SolucaoMedida = Solucao<RastreioNulo, EstatisticasBusca>;
+
+// Acrescenta uma linha JSON com as estatísticas de um quebra-cabeça
+void escrever_estatisticas(std::size_t indice, bool resolvido, const EstatisticasBusca &estatisticas, std::string &saida)
+{
+    saida += "{\"indice\": " + std::to_string(indice) + ", \"resolvido\": " + (resolvido ? "true" : "false") + ", ";
+    estatisticas.escrever_campos_json(saida);
+    saida += "}\n";
+}
+
+// Resolve todas as linhas da fonte (FonteTexto ou FonteBinaria) em paralelo, em blocos distribuídos com roubo de trabalho.
+// Cada thread tem o seu próprio solucionador e tabuleiro; a saída (se houver) mantém a ordem da entrada.
+// O motor paralelo já divide cada tabuleiro entre as num_threads threads, então com ele o lote resolve um por vez.
+// Com saida_estatisticas, cada quebra-cabeça gera também uma linha JSON com os seus contadores,
+// na mesma ordem, e a última linha traz o total do lote. Com cache, cada quebra-cabeça é procurado
+// pela forma canônica antes de ir para o solucionador.
+template <class Fonte>
+ResultadoLote resolver_lote(Fonte &fonte, unsigned num_threads, Motor motor, std::ostream *saida,
+                            std::ostream *saida_estatisticas = nullptr, CacheSolucoes *cache = nullptr)
+{
+    std::size_t num_blocos = (fonte.tamanho() + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    std::vector<std::size_t> resolvidos_por_bloco(num_blocos, 0);
+    std::vector<EstatisticasBusca> estatisticas_por_bloco(saida_estatisticas ? num_blocos : 0);
+    EscritorOrdenado escritor(saida, num_blocos);
+    EscritorOrdenado escritor_estatisticas(saida_estatisticas, num_blocos);
+    unsigned threads_lote = motor == Motor::Paralelo ? 1 : num_threads;
+
+    // Estado de cada thread: solucionador e tabuleiro próprios
+    std::vector<Solucionador> solucionadores =
+        criar_solucionadores(saida_estatisticas || cache ? 0 : threads_lote, motor, num_threads);
+    std::vector<SolucaoMedida> medidores(saida_estatisticas && !cache ? threads_lote : 0);
+    std::vector<ResolvedorComCache<Solucionador>> com_cache;
+    if (cache)
+        com_cache = criar_com_cache(threads_lote, motor, num_threads, *cache);
+    std::vector<Tabuleiro> tabuleiros(threads_lote);
+
+    auto inicio = std::chrono::steady_clock::now();
+    executar_blocos(num_blocos, threads_lote, [&](std::size_t bloco, unsigned id)
+                    {
+        std::string texto;
+        std::string texto_estatisticas;
+        std::string buffer;
+        std::size_t resolvidos = 0;
+        std::size_t fim = std::min(fonte.tamanho(), (bloco + 1) * TAMANHO_BLOCO);
+        // O motor intercalado recebe o bloco inteiro de uma vez
+        if (motor == Motor::Intercalado && !cache && !saida_estatisticas)
+            resolvidos = resolver_bloco(solucionadores[id], fonte, bloco * TAMANHO_BLOCO, fim, id, texto);
+        else for (std::size_t i = bloco * TAMANHO_BLOCO; i < fim; ++i)
+        {
+            std::string_view linha = fonte.linha(i, id, buffer);
+            if (cache)
             {
-                if (s.count(c))
-                    return "Número repetido na linha " + std::to_string(i + 1) + ".";
-                s.insert(c);
+                resolvidos += resolver_linha(com_cache[id], linha, tabuleiros[id], texto);
+                continue;
             }
+            if (!saida_estatisticas)
+            {
+                if (resolver_linha(solucionadores[id], linha, tabuleiros[id], texto))
+                    ++resolvidos;
+                continue;
+            }
+            EstatisticasBusca &estatisticas = medidores[id].estatisticas();
+            estatisticas.zerar();
+            bool resolveu = resolver_linha(medidores[id], linha, tabuleiros[id], texto);
+            resolvidos += resolveu;
+            escrever_estatisticas(i, resolveu, estatisticas, texto_estatisticas);
+            estatisticas_por_bloco[bloco].somar(estatisticas);
         }
+        resolvidos_por_bloco[bloco] = resolvidos;
+        escritor.entregar(bloco, std::move(texto));
+        escritor_estatisticas.entregar(bloco, std::move(texto_estatisticas)); });
+    auto fim = std::chrono::steady_clock::now();
+    escritor.finalizar();
+    escritor_estatisticas.finalizar();
+
+    ResultadoLote resultado;
+    resultado.total = fonte.tamanho();
+    for (std::size_t r : resolvidos_por_bloco)
+        resultado.resolvidos += r;
+    resultado.segundos = std::chrono::duration<double>(fim - inicio).count();
+    for (const ResolvedorComCache<Solucionador> &resolvedor : com_cache)
+        resultado.cache.somar(resolvedor.estatisticas());
+
+    // Com cache, as estatísticas são só os contadores do cache (os acertos não passam pela busca)
+    if (saida_estatisticas && cache)
+    {
+        std::string texto = "{\"total\": true, \"quebra_cabecas\": " + std::to_string(resultado.total) +
+                            ", \"resolvidos\": " + std::to_string(resultado.resolvidos) + ", ";
+        resultado.cache.escrever_campos_json(texto);
+        texto += "}\n";
+        *saida_estatisticas << texto << std::flush;
     }
-    // Verifica repetição nas colunas
-    for (int j = 0; j < 9; ++j)
+    // Total do lote: soma dos contadores e dos tempos, maior profundidade
+    else if (saida_estatisticas)
     {
-        std::set<char> s;
-        for (int i = 0; i < 9; ++i)
+        EstatisticasBusca total;
+        for (const EstatisticasBusca &estatisticas : estatisticas_por_bloco)
+            total.somar(estatisticas);
+        std::string texto = "{\"total\": true, \"quebra_cabecas\": " + std::to_string(resultado.total) +
+                            ", \"resolvidos\": " + std::to_string(resultado.resolvidos) + ", ";
+        total.escrever_campos_json(texto);
+        texto += "}\n";
+        *saida_estatisticas << texto << std::flush;
+    }
+    return resultado;
+}
+
+// Resolve um lote de tabuleiros LADO x LADO (16x16 ou 25x25) em paralelo, como resolver_lote,
+// com o solucionador N x N (propagação de singles e chute MRV) de cada thread
+template <std::size_t Caixa>
+ResultadoLote resolver_lote_n(FonteTexto &fonte, unsigned num_threads, std::ostream *saida)
+{
+    std::size_t num_blocos = (fonte.tamanho() + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    std::vector<std::size_t> resolvidos_por_bloco(num_blocos, 0);
+    EscritorOrdenado escritor(saida, num_blocos);
+    std::vector<SolucaoN<Caixa>> solucionadores(num_threads);
+    std::vector<TabuleiroN<Caixa>> tabuleiros(num_threads);
+
+    auto inicio = std::chrono::steady_clock::now();
+    executar_blocos(num_blocos, num_threads, [&](std::size_t bloco, unsigned id)
+                    {
+        std::string texto;
+        std::string buffer;
+        std::size_t resolvidos = 0;
+        std::size_t fim = std::min(fonte.tamanho(), (bloco + 1) * TAMANHO_BLOCO);
+        for (std::size_t i = bloco * TAMANHO_BLOCO; i < fim; ++i)
+            resolvidos += resolver_linha(solucionadores[id], fonte.linha(i, id, buffer), tabuleiros[id], texto);
+        resolvidos_por_bloco[bloco] = resolvidos;
+        escritor.entregar(bloco, std::move(texto)); });
+    auto fim = std::chrono::steady_clock::now();
+    escritor.finalizar();
+
+    ResultadoLote resultado;
+    resultado.total = fonte.tamanho();
+    for (std::size_t r : resolvidos_por_bloco)
+        resultado.resolvidos += r;
+    resultado.segundos = std::chrono::duration<double>(fim - inicio).count();
+    return resultado;
+}
+
+// Mostra o resumo de uma execução em lote no stderr, para não misturar com as soluções
+void imprimir_resumo(const ResultadoLote &resultado, unsigned num_threads, Motor motor)
+{
+    std::cerr << "Quebra-cabeças: " << resultado.total << " | Resolvidos: " << resultado.resolvidos
+              << " | Motor: " << nome_motor(motor) << " | Threads: " << num_threads
+              << " | Tempo total: " << resultado.segundos * 1000.0 << " ms"
+              << " | Quebra-cabeças/s: " << (resultado.segundos > 0 ? resultado.total / resultado.segundos : 0.0) << std::endl;
+
+    const EstatisticasCache &cache = resultado.cache;
+    if (cache.consultas > 0)
+    {
+        double consultas = static_cast<double>(cache.consultas);
+        std::cerr << "Cache: " << cache.consultas << " consultas | Acertos na memória: " << cache.acertos_memoria
+                  << " | Acertos no disco: " << cache.acertos_disco << " | Sem forma canônica: " << cache.sem_forma
+                  << " | Taxa de acerto: " << 100.0 * static_cast<double>(cache.acertos()) / consultas << "%"
+                  << " | Canonização média: " << cache.segundos_canonizacao * 1e6 / consultas << " us"
+                  << " | Consulta média: " << cache.segundos_consulta * 1e6 / consultas << " us" << std::endl;
+    }
+}
+
+// Roda o lote sem saída com 1, 2, 4, ... threads até o máximo e mostra a vazão de cada uma
+template <class Fonte>
+void medir_escalonamento(Fonte &fonte, unsigned max_threads, Motor motor)
+{
+    std::cerr << "Threads | Tempo (ms) | Quebra-cabeças/s | Aceleração\n";
+    double base = 0.0;
+    for (unsigned t = 1;; t = std::min(t * 2, max_threads))
+    {
+        ResultadoLote resultado = resolver_lote(fonte, t, motor, nullptr);
+        double vazao = resultado.segundos > 0 ? resultado.total / resultado.segundos : 0.0;
+        if (t == 1)
+            base = vazao;
+        std::cerr << t << " | " << resultado.segundos * 1000.0 << " | " << vazao
+                  << " | " << (base > 0 ? vazao / base : 0.0) << "x\n";
+        if (t >= max_threads)
+            break;
+    }
+}
+
+// Nota com uma casa decimal, como na escala do Sudoku Explainer
+std::string texto_nota(double nota)
+{
+    char texto[8];
+    std::snprintf(texto, sizeof(texto), "%.1f", nota);
+    return texto;
+}
+
+// Classifica todas as linhas em paralelo. Cada linha de saída repete a entrada seguida da nota
+// e da técnica mais difícil ("linha ; 3.2 ; x-wing"); linhas inválidas saem com o motivo.
+// Retorna quantas linhas de cada técnica foram encontradas e o tempo gasto.
+template <class Fonte>
+ResultadoLote classificar_lote(Fonte &fonte, unsigned num_threads, std::ostream &saida,
+                               std::array<std::size_t, NUM_TECNICAS> &por_tecnica)
+{
+    std::size_t num_blocos = (fonte.tamanho() + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO;
+    std::vector<std::array<std::size_t, NUM_TECNICAS>> contagem_por_bloco(num_blocos);
+    EscritorOrdenado escritor(&saida, num_blocos);
+
+    // Classificador e tabuleiro próprios de cada thread
+    std::vector<Classificador> classificadores(num_threads);
+    std::vector<Tabuleiro> tabuleiros(num_threads);
+
+    auto inicio = std::chrono::steady_clock::now();
+    executar_blocos(num_blocos, num_threads, [&](std::size_t bloco, unsigned id)
+                    {
+        std::string texto;
+        std::string buffer;
+        std::array<std::size_t, NUM_TECNICAS> contagem{};
+        std::size_t fim = std::min(fonte.tamanho(), (bloco + 1) * TAMANHO_BLOCO);
+        for (std::size_t i = bloco * TAMANHO_BLOCO; i < fim; ++i)
         {
-            char c = tabuleiro[i][j];
-            if (c != '.')
+            std::string motivo;
+            Tabuleiro &tabuleiro = tabuleiros[id];
+            std::string_view linha = fonte.linha(i, id, buffer);
+            if (!linha_para_tabuleiro(linha, tabuleiro))
+                motivo = "Linha com tamanho diferente de 81 caracteres.";
+            else
+                motivo = validar_tabuleiro(tabuleiro);
+
+            texto += linha;
+            texto += " ; ";
+            if (motivo.empty())
+            {
+                Classificacao classificacao = classificadores[id].classificar(tabuleiro);
+                contagem[static_cast<std::size_t>(classificacao.mais_dificil)]++;
+                texto += texto_nota(classificacao.nota);
+                texto += " ; ";
+                texto += nome_tecnica(classificacao.mais_dificil);
+            }
+            else
             {
-                if (s.count(c))
-                    return "Número repetido na coluna " + std::to_string(j + 1) + ".";
-                s.insert(c);
+                texto += motivo;
             }
+            texto += '\n';
+        }
+        contagem_por_bloco[bloco] = contagem;
+        escritor.entregar(bloco, std::move(texto)); });
+    auto fim = std::chrono::steady_clock::now();
+    escritor.finalizar();
+
+    ResultadoLote resultado;
+    resultado.total = fonte.tamanho();
+    por_tecnica.fill(0);
+    for (const auto &contagem : contagem_por_bloco)
+    {
+        for (std::size_t t = 0; t < NUM_TECNICAS; ++t)
+        {
+            por_tecnica[t] += contagem[t];
+            resultado.resolvidos += contagem[t];
         }
     }
-    // Verifica repetição nos blocos 3x3
-    for (int bi = 0; bi < 3; ++bi)
+    resultado.segundos = std::chrono::duration<double>(fim - inicio).count();
+    return resultado;
+}
+
+// Confere, linha a linha, as soluções de um arquivo (por exemplo, a saída do modo em lote) contra os
+// quebra-cabeças de outro. Escreve "linha N: motivo" para cada solução errada e retorna 1 se houver alguma.
+int verificar_lote(const std::string &caminho_quebra_cabecas, const std::string &caminho_solucoes)
+{
+    EntradaQuebraCabecas quebra_cabecas, solucoes;
+    if (!ler_entrada(caminho_quebra_cabecas, quebra_cabecas) || !ler_entrada(caminho_solucoes, solucoes))
+        return 1;
+    const auto &linhas = quebra_cabecas.linhas();
+    const auto &respostas = solucoes.linhas();
+    if (linhas.size() != respostas.size())
+        std::cout << "Quantidade de linhas diferente: " << linhas.size() << " quebra-cabeças e "
+                  << respostas.size() << " soluções\n";
+
+    std::size_t total = std::min(linhas.size(), respostas.size());
+    std::size_t certas = 0;
+    Tabuleiro quebra_cabeca, solucao;
+    std::string saida;
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < total; ++i)
     {
-        for (int bj = 0; bj < 3; ++bj)
+        std::string motivo;
+        if (!linha_para_tabuleiro(linhas[i], quebra_cabeca) || !linha_para_tabuleiro(respostas[i], solucao))
+            motivo = "Linha com tamanho diferente de 81 caracteres.";
+        else
+            motivo = verificar_solucao(quebra_cabeca, solucao);
+        if (motivo.empty())
         {
-            std::set<char> s;
-            for (int i = 0; i < 3; ++i)
-            {
-                for (int j = 0; j < 3; ++j)
-                {
-                    char c = tabuleiro[3 * bi + i][3 * bj + j];
-                    if (c != '.')
-                    {
-                        if (s.count(c))
-                            return "Número repetido no bloco 3x3 começando em linha " +
-                                   std::to_string(3 * bi + 1) + ", coluna " + std::to_string(3 * bj + 1) + ".";
-                        s.insert(c);
-                    }
-                }
-            }
+            ++certas;
+            continue;
         }
+        saida += "linha " + std::to_string(i + 1) + ": " + motivo + '\n';
     }
-    // Verifica caracteres inválidos
-    for (int i = 0; i < 9; ++i)
-        for (int j = 0; j < 9; ++j)
-            if (tabuleiro[i][j] != '.' && (tabuleiro[i][j] < '1' || tabuleiro[i][j] > '9'))
-                return "Caractere inválido na posição linha " + std::to_string(i + 1) +
-                       ", coluna " + std::to_string(j + 1) + ".";
-    return ""; // Retorna string vazia se não encontrar problema
+    auto fim = std::chrono::steady_clock::now();
+    double segundos = std::chrono::duration<double>(fim - inicio).count();
+    std::cout << saida << std::flush;
+    std::cerr << "Conferidas: " << total << " | Certas: " << certas << " | Tempo total: " << segundos * 1000.0
+              << " ms | Tabuleiros/s: " << (segundos > 0 ? static_cast<double>(total) / segundos : 0.0) << std::endl;
+    return certas == total && linhas.size() == respostas.size() ? 0 : 1;
 }
 
-// Classe que resolve o Sudoku usando backtracking otimizado com bitset
-class Solucao
+// Conta as soluções de cada tabuleiro do arquivo, um por vez, com a busca dividida entre as threads.
+// Cada linha da saída é a quantidade de soluções (um valor igual ao limite quer dizer "pelo menos")
+// ou a linha de entrada seguida do motivo, como no modo em lote.
+int contar_lote(const std::string &caminho, unsigned num_threads, std::size_t limite)
 {
-public:
-    // Função principal: resolve o Sudoku, retorna true se conseguiu, false se não tem solução
-    bool resolverSudoku(std::vector<std::vector<char>> &tabuleiro) const noexcept
+    EntradaQuebraCabecas entrada;
+    if (!ler_entrada(caminho, entrada))
+        return 1;
+    SolucaoParalela solucionador(num_threads);
+    Tabuleiro tabuleiro;
+    std::string saida;
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::string_view linha : entrada.linhas())
     {
-        // Bitsets que marcam os números já usados em cada linha, coluna e região 3x3
-        std::array<std::bitset<9>, 9> linha_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-        std::array<std::bitset<9>, 9> coluna_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-        std::array<std::bitset<9>, 9> regiao_contem = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+        std::string motivo = linha_para_tabuleiro(linha, tabuleiro) ? solucionador.validarTabuleiro(tabuleiro)
+                                                                    : "Linha com tamanho diferente de 81 caracteres.";
+        if (motivo.empty())
+            saida += std::to_string(solucionador.contarSolucoes(tabuleiro, limite));
+        else
+        {
+            saida += linha;
+            saida += " ; ";
+            saida += motivo;
+        }
+        saida += '\n';
+    }
+    auto fim = std::chrono::steady_clock::now();
+    std::cout << saida << std::flush;
+    std::cerr << "Quebra-cabeças: " << entrada.linhas().size() << " | Threads: " << num_threads
+              << " | Tempo total: " << std::chrono::duration<double, std::milli>(fim - inicio).count() << " ms" << std::endl;
+    return 0;
+}
 
-        // Preenche os bitsets com o estado inicial do tabuleiro
-        for (std::size_t linha = 0; linha < 9; ++linha)
+// Partida interativa: cada jogada atualiza o estado em O(1), sem validar nem resolver o tabuleiro de novo
+int jogar(const std::string &nome_arquivo)
+{
+    Jogo jogo;
+    std::string motivo = jogo.iniciar(carregar_tabuleiro(nome_arquivo));
+    if (!motivo.empty())
+    {
+        std::cout << "Jogo não pode começar por conta do motivo: " << motivo << std::endl;
+        return 1;
+    }
+    if (!jogo.solucao_unica())
+        std::cout << "Atenção: o tabuleiro tem mais de uma solução; as dicas e os erros usam uma delas.\n";
+
+    std::cout << "Comandos: L C D coloca o dígito D na linha L, coluna C (D = 0 apaga) | c L C mostra os candidatos\n"
+              << "          d pede uma dica | v verifica os erros | u desfaz a última jogada | s sai\n";
+    imprimir_tabuleiro(jogo.tabuleiro());
+    std::string comando;
+    while (std::cout << "> " << std::flush && std::getline(std::cin, comando))
+    {
+        std::istringstream partes(comando);
+        std::string primeiro;
+        if (!(partes >> primeiro))
+            continue;
+
+        if (primeiro == "s")
+            break;
+        if (primeiro == "u")
+        {
+            if (!jogo.desfazer())
+                std::cout << "Nada para desfazer.\n";
+            imprimir_tabuleiro(jogo.tabuleiro());
+            continue;
+        }
+        if (primeiro == "v")
         {
-            for (std::size_t coluna = 0; coluna < 9; ++coluna)
+            std::cout << "Conflitos: " << jogo.conflitos() << " | Erros: " << jogo.erros()
+                      << " | Células vazias: " << jogo.celulas_vazias() << "\n";
+            continue;
+        }
+        if (primeiro == "d")
+        {
+            Dica dica = jogo.dica();
+            if (dica.celula == 81)
+                std::cout << "Nenhuma dica: o tabuleiro já está completo.\n";
+            else if (dica.corrigir)
+                std::cout << "Corrija a linha " << dica.celula / 9 + 1 << ", coluna " << dica.celula % 9 + 1
+                          << ": o dígito certo é " << dica.digito << "\n";
+            else
+                std::cout << "Dica: linha " << dica.celula / 9 + 1 << ", coluna " << dica.celula % 9 + 1
+                          << " = " << dica.digito << " (técnica: " << nome_tecnica(dica.tecnica) << ")\n";
+            continue;
+        }
+        if (primeiro == "c")
+        {
+            int linha = 0, coluna = 0;
+            if (!(partes >> linha >> coluna) || linha < 1 || linha > 9 || coluna < 1 || coluna > 9)
             {
-                char digito;
-                if ((digito = tabuleiro[linha][coluna]) != '.')
-                {
-                    std::size_t idx_digito = digito - '1'; // Transforma '1'..'9' em 0..8
-                    linha_contem[linha].set(idx_digito);
-                    coluna_contem[coluna].set(idx_digito);
-                    std::size_t regiao = obter_regiao(linha, coluna);
-                    regiao_contem[regiao].set(idx_digito);
-                }
+                std::cout << "Use: c linha coluna (1 a 9)\n";
+                continue;
             }
+            Mascara candidatos = jogo.candidatos(static_cast<std::size_t>((linha - 1) * 9 + coluna - 1));
+            std::cout << "Candidatos:";
+            for (int d = 0; d < 9; ++d)
+                if (candidatos & (1u << d))
+                    std::cout << ' ' << d + 1;
+            std::cout << "\n";
+            continue;
         }
-        // Chama a função recursiva para resolver o tabuleiro a partir da célula (0,0)
-        return resolver(tabuleiro, 0, 0, linha_contem, coluna_contem, regiao_contem);
-    }
 
-private:
-    // Função auxiliar que retorna a próxima posição vazia a partir de (linha, coluna)
-    static constexpr std::pair<std::size_t, std::size_t> proxima_posicao_vazia(const std::vector<std::vector<char>> &tabuleiro, std::size_t linha, std::size_t coluna) noexcept
-    {
-        while (linha != 9)
+        // Jogada: linha, coluna e dígito
+        int linha = std::atoi(primeiro.c_str()), coluna = 0, digito = -1;
+        if (!(partes >> coluna >> digito) || digito < 0 || digito > 9)
+        {
+            std::cout << "Comando desconhecido: " << comando << "\n";
+            continue;
+        }
+        ResultadoJogada resultado = jogo.jogar(static_cast<std::size_t>(linha - 1), static_cast<std::size_t>(coluna - 1),
+                                               digito == 0 ? '.' : static_cast<char>('0' + digito));
+        if (resultado == ResultadoJogada::Invalida)
+            std::cout << "Jogada inválida: use linha, coluna e dígito de 1 a 9 (0 apaga).\n";
+        else if (resultado == ResultadoJogada::Fixa)
+            std::cout << "Essa célula é uma pista do quebra-cabeça e não pode mudar.\n";
+        else
         {
-            if (tabuleiro[linha][coluna] == '.')
+            if (resultado == ResultadoJogada::Conflito)
+                std::cout << "Conflito: o dígito já aparece na linha, coluna ou região.\n";
+            imprimir_tabuleiro(jogo.tabuleiro());
+            if (jogo.resolvido())
             {
-                return {linha, coluna}; // Retorna se achou célula vazia
+                std::cout << "Parabéns, Sudoku resolvido!\n";
+                return 0;
             }
-            linha = proxima_linha(linha, coluna);
-            coluna = proxima_coluna(coluna);
         }
-        return {9, 0}; // Não encontrou: fim do tabuleiro
     }
+    return 0;
+}
 
-    // Função recursiva de backtracking: preenche as células uma a uma
-    static bool resolver(std::vector<std::vector<char>> &tabuleiro, std::size_t linha_inicio, std::size_t coluna_inicio,
-                         std::array<std::bitset<9>, 9> &linha_contem,
-                         std::array<std::bitset<9>, 9> &coluna_contem,
-                         std::array<std::bitset<9>, 9> &regiao_contem) noexcept
-    {
-        // Busca a próxima célula vazia para preencher
-        auto [linha, coluna] = proxima_posicao_vazia(tabuleiro, linha_inicio, coluna_inicio);
+int main(int argc, char *argv[])
+{
+    std::setlocale(LC_ALL, "pt_BR.UTF-8"); // Configura acentuação no terminal
 
-        // Se linha == 9, terminou o tabuleiro, solução encontrada
-        if (linha == 9)
+    // Grava os passos da resolução em binário: SudokuResolver.exe --gravar-passos tabuleiro.txt passos.bin
+    if (argc > 3 && std::strcmp(argv[1], "--gravar-passos") == 0)
+    {
+        Tabuleiro tabuleiro = carregar_tabuleiro(argv[2]);
+        std::string motivo = validar_tabuleiro(tabuleiro);
+        if (!motivo.empty())
         {
-            return true;
+            std::cout << "Jogo não tem solução por conta do motivo: " << motivo << std::endl;
+            return 1;
+        }
+        Tabuleiro inicial = tabuleiro;
+        Solucao<RastreioBinario> solucao;
+        bool resolveu = solucao.resolverSudoku(tabuleiro);
+        if (!salvar_passos(argv[3], inicial, solucao.rastreio().passos()))
+        {
+            std::cout << "Não foi possível salvar o arquivo: " << argv[3] << "\n";
+            return 1;
         }
+        std::cout << (resolveu ? "Sudoku resolvido" : "Não existe solução para o tabuleiro de Sudoku informado")
+                  << "; " << solucao.rastreio().passos().size() << " passos gravados em " << argv[3] << "\n";
+        return 0;
+    }
 
-        // Calcula qual região 3x3 a célula pertence
-        std::size_t regiao = obter_regiao(linha, coluna);
-        // Junta os números usados na linha, coluna e região
-        std::bitset<9> contem = linha_contem[linha] | coluna_contem[coluna] | regiao_contem[regiao];
-        // Se todos os dígitos já estão presentes, não há solução por aqui
-        if (contem.all())
+    // Reproduz no terminal os passos gravados: SudokuResolver.exe --reproduzir passos.bin
+    if (argc > 2 && std::strcmp(argv[1], "--reproduzir") == 0)
+    {
+        Tabuleiro inicial;
+        std::vector<std::uint16_t> passos;
+        if (!carregar_passos(argv[2], inicial, passos))
         {
-            return false;
+            std::cout << "Não foi possível abrir o arquivo: " << argv[2] << "\n";
+            return 1;
         }
+        std::cout << "Quebra-cabeça de Sudoku carregado:\n";
+        imprimir_tabuleiro(inicial);
+        RastreioTexto texto;
+        RastreioBinario::reproduzir(passos, inicial, texto);
+        return 0;
+    }
 
-        // Tenta preencher de 1 a 9 (índice 0 a 8)
-        for (std::size_t idx_digito = 0; idx_digito < 9; ++idx_digito)
+    // Modo em lote: SudokuResolver.exe --lote [arquivo] [--threads N] [--motor nome] [--escalonamento]
+    //                                        [--estatisticas arquivo.jsonl] [--tamanho 9|16|25]
+    //                                        [--cache N] [--indice-cache arquivo]
+    // Sem arquivo (ou com "-") lê da entrada padrão; o arquivo pode estar no formato binário compacto
+    if (argc > 1 && std::strcmp(argv[1], "--lote") == 0)
+    {
+        const char *uso = "--lote [arquivo] [--threads N] [--motor nome] [--escalonamento] [--estatisticas arquivo.jsonl]"
+                          " [--tamanho 9|16|25] [--cache N] [--indice-cache arquivo]";
+        std::ios::sync_with_stdio(false);
+        std::string caminho = "-";
+        bool tem_caminho = false;
+        unsigned num_threads = threads_disponiveis();
+        bool escalonamento = false;
+        Motor motor = Motor::Propagacao;
+        const char *nome_estatisticas = nullptr;
+        int lado = 9;
+        long capacidade_cache = -1;
+        const char *nome_indice = nullptr;
+        for (int i = 2; i < argc; ++i)
         {
-            if (!contem[idx_digito])
+            if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                num_threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+            else if (std::strcmp(argv[i], "--motor") == 0 && i + 1 < argc)
             {
-                // Marca a célula com o dígito
-                tabuleiro[linha][coluna] = static_cast<char>(idx_digito + '1');
-                // Atualiza os bitsets
-                linha_contem[linha].set(idx_digito);
-                coluna_contem[coluna].set(idx_digito);
-                regiao_contem[regiao].set(idx_digito);
-
-                // Mostra no terminal o passo atual (debug)
-                std::cout << "\nColocando " << (char)(idx_digito + '1') << " em (" << linha << ", " << coluna << ")\n";
-                imprimir_tabuleiro(tabuleiro);
-
-                // Chama recursivamente para o próximo espaço vazio
-                if (resolver(tabuleiro, linha, coluna, linha_contem, coluna_contem, regiao_contem))
+                if (!ler_motor(argv[++i], motor))
                 {
-                    return true; // Encontrou solução!
+                    std::cerr << "Motor desconhecido: " << argv[i] << " (use propagacao, dlx, simd, paralelo ou intercalado)\n";
+                    return 1;
                 }
+            }
+            else if (std::strcmp(argv[i], "--escalonamento") == 0)
+                escalonamento = true;
+            else if (std::strcmp(argv[i], "--estatisticas") == 0 && i + 1 < argc)
+                nome_estatisticas = argv[++i];
+            else if (std::strcmp(argv[i], "--tamanho") == 0 && i + 1 < argc)
+                lado = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+                capacidade_cache = std::max(0L, std::atol(argv[++i]));
+            else if (std::strcmp(argv[i], "--indice-cache") == 0 && i + 1 < argc)
+                nome_indice = argv[++i];
+            // Uma opção errada (ou sem o valor, no fim) não pode virar o nome do arquivo
+            else if (e_opcao(argv[i]))
+                return erro_de_uso(std::string("Opção desconhecida ou sem valor: ") + argv[i], uso);
+            else if (tem_caminho)
+                return erro_de_uso(std::string("Mais de um arquivo informado: ") + caminho + " e " + argv[i], uso);
+            else
+            {
+                caminho = argv[i];
+                tem_caminho = true;
+            }
+        }
+        // O índice em disco sozinho usa um LRU de tamanho padrão
+        if (nome_indice && capacidade_cache < 0)
+            capacidade_cache = 100000;
+        bool usar_cache = capacidade_cache >= 0;
+        if (usar_cache && escalonamento)
+        {
+            std::cerr << "--cache não combina com --escalonamento\n";
+            return 1;
+        }
+        if (nome_estatisticas && motor != Motor::Propagacao)
+        {
+            std::cerr << "As estatísticas só existem para o motor propagacao\n";
+            return 1;
+        }
+        // 16x16 e 25x25: só texto e o motor de propagação N x N
+        if (lado != 9)
+        {
+            if (lado != 16 && lado != 25)
+            {
+                std::cerr << "Tamanho não suportado: " << lado << " (use 9, 16 ou 25)\n";
+                return 1;
+            }
+            if (motor != Motor::Propagacao || nome_estatisticas || escalonamento || usar_cache)
+            {
+                std::cerr << "--motor, --estatisticas, --escalonamento e --cache só existem no 9x9\n";
+                return 1;
+            }
+            EntradaQuebraCabecas entrada;
+            if (!ler_entrada(caminho, entrada))
+                return 1;
+            FonteTexto fonte(entrada.linhas());
+            ResultadoLote resultado = lado == 16 ? resolver_lote_n<4>(fonte, num_threads, &std::cout)
+                                                 : resolver_lote_n<5>(fonte, num_threads, &std::cout);
+            imprimir_resumo(resultado, num_threads, motor);
+            return resultado.resolvidos == resultado.total ? 0 : 1;
+        }
 
-                // Caso não dê certo, desfaz o movimento (backtracking)
-                std::cout << "\nRetrocedendo em (" << linha << ", " << coluna << ")\n";
-                imprimir_tabuleiro(tabuleiro);
+        // Cache de soluções pela forma canônica, com o índice em disco opcional
+        CacheSolucoes cache(usar_cache ? static_cast<std::size_t>(capacidade_cache) : 0);
+        if (nome_indice && !cache.abrir_indice(nome_indice))
+        {
+            std::cerr << "Não foi possível abrir o arquivo: " << nome_indice << "\n";
+            return 1;
+        }
 
-                tabuleiro[linha][coluna] = '.';
-                linha_contem[linha].reset(idx_digito);
-                coluna_contem[coluna].reset(idx_digito);
-                regiao_contem[regiao].reset(idx_digito);
+        // O arquivo pode ser texto ou binário (SudokuCriar.exe --compactar / --gerar ... --binario)
+        return com_fonte(caminho, num_threads, [&](auto &fonte)
+                         {
+            if (escalonamento)
+            {
+                medir_escalonamento(fonte, num_threads, motor);
+                return 0;
             }
-        }
-        return false; // Não achou solução nesse caminho
+
+            // Estatísticas em JSON, uma linha por quebra-cabeça ("-" manda para o stderr)
+            std::ofstream arquivo_estatisticas;
+            std::ostream *saida_estatisticas = nullptr;
+            if (nome_estatisticas)
+            {
+                if (std::strcmp(nome_estatisticas, "-") == 0)
+                    saida_estatisticas = &std::cerr;
+                else
+                {
+                    arquivo_estatisticas.open(nome_estatisticas);
+                    if (!arquivo_estatisticas.is_open())
+                    {
+                        std::cerr << "Não foi possível abrir o arquivo: " << nome_estatisticas << "\n";
+                        return 1;
+                    }
+                    saida_estatisticas = &arquivo_estatisticas;
+                }
+            }
+            ResultadoLote resultado = resolver_lote(fonte, num_threads, motor, &std::cout, saida_estatisticas,
+                                                    usar_cache ? &cache : nullptr);
+            cache.descarregar();
+            imprimir_resumo(resultado, num_threads, motor);
+            return resultado.resolvidos == resultado.total ? 0 : 1; });
     }
 
-    // Funções auxiliares para avançar para a próxima célula do tabuleiro
-    static constexpr std::size_t proxima_linha(std::size_t linha, std::size_t coluna) noexcept
+    // Confere soluções: SudokuResolver.exe --verificar quebra_cabecas.txt solucoes.txt
+    if (argc > 3 && std::strcmp(argv[1], "--verificar") == 0)
     {
-        return linha + (coluna + 1) / 9;
+        std::ios::sync_with_stdio(false);
+        return verificar_lote(argv[2], argv[3]);
     }
 
-    static constexpr std::size_t proxima_coluna(std::size_t coluna) noexcept
+    // Conta as soluções: SudokuResolver.exe --contar [arquivo] [--limite N] [--threads N]
+    if (argc > 1 && std::strcmp(argv[1], "--contar") == 0)
     {
-        return (coluna + 1) % 9;
+        const char *uso = "--contar [arquivo] [--limite N] [--threads N]";
+        std::ios::sync_with_stdio(false);
+        std::string caminho = "-";
+        bool tem_caminho = false;
+        unsigned num_threads = threads_disponiveis();
+        std::size_t limite = 2;
+        for (int i = 2; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                num_threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+            else if (std::strcmp(argv[i], "--limite") == 0 && i + 1 < argc)
+                limite = static_cast<std::size_t>(std::max(1L, std::atol(argv[++i])));
+            // Como no lote, uma opção errada (ou sem o valor) não pode virar o nome do arquivo
+            else if (e_opcao(argv[i]))
+                return erro_de_uso(std::string("Opção desconhecida ou sem valor: ") + argv[i], uso);
+            else if (tem_caminho)
+                return erro_de_uso(std::string("Mais de um arquivo informado: ") + caminho + " e " + argv[i], uso);
+            else
+            {
+                caminho = argv[i];
+                tem_caminho = true;
+            }
+        }
+        return contar_lote(caminho, num_threads, limite);
     }
-};
 
-// Função para carregar um tabuleiro de Sudoku de um arquivo texto
-std::vector<std::vector<char>> carregar_tabuleiro(const std::string &nome_arquivo)
-{
-    std::vector<std::vector<char>> tabuleiro(9, std::vector<char>(9, '.')); // Inicializa tudo vazio
-    std::ifstream arquivo(nome_arquivo);
-    if (arquivo.is_open())
+    // Partida no terminal: SudokuResolver.exe --jogar tabuleiro.txt
+    if (argc > 2 && std::strcmp(argv[1], "--jogar") == 0)
+        return jogar(argv[2]);
+
+    // Serviço de longa duração: SudokuResolver.exe --servico [--socket caminho] [--threads N] [--fila N]
+    //                                                [--motor nome] [--cache N] [--fatia-us N]
+    // Sem --socket atende a entrada padrão até ela acabar; com --socket atende conexões até ser encerrado
+    if (argc > 1 && std::strcmp(argv[1], "--servico") == 0)
     {
-        // Lê caractere a caractere, preenchendo o tabuleiro
-        for (std::size_t linha = 0; linha < 9; ++linha)
+        const char *uso = "--servico [--socket caminho] [--threads N] [--fila N] [--motor nome] [--cache N] [--fatia-us N]";
+        std::ios::sync_with_stdio(false);
+        const char *caminho_socket = nullptr;
+        unsigned num_threads = threads_disponiveis();
+        std::size_t capacidade_fila = 1024;
+        Motor motor = Motor::Propagacao;
+        long capacidade_cache = -1;
+        std::chrono::microseconds fatia{0};
+        for (int i = 2; i < argc; ++i)
         {
-            for (std::size_t coluna = 0; coluna < 9; ++coluna)
+            if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+                caminho_socket = argv[++i];
+            else if (std::strcmp(argv[i], "--fatia-us") == 0 && i + 1 < argc)
+                fatia = std::chrono::microseconds(std::max(0L, std::atol(argv[++i])));
+            else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                num_threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+            else if (std::strcmp(argv[i], "--fila") == 0 && i + 1 < argc)
+                capacidade_fila = static_cast<std::size_t>(std::max(1L, std::atol(argv[++i])));
+            else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+                capacidade_cache = std::max(0L, std::atol(argv[++i]));
+            else if (std::strcmp(argv[i], "--motor") == 0 && i + 1 < argc)
             {
-                arquivo >> tabuleiro[linha][coluna];
+                if (!ler_motor(argv[++i], motor))
+                {
+                    std::cerr << "Motor desconhecido: " << argv[i] << " (use propagacao, dlx, simd, paralelo ou intercalado)\n";
+                    return 1;
+                }
             }
+            // O serviço não lê arquivo: qualquer outro argumento é um erro
+            else if (e_opcao(argv[i]))
+                return erro_de_uso(std::string("Opção desconhecida ou sem valor: ") + argv[i], uso);
+            else
+                return erro_de_uso(std::string("Argumento inesperado: ") + argv[i], uso);
+        }
+
+        // As fatias usam a busca iterativa do motor propagacao, que guarda o estado entre uma fatia e outra
+        if (fatia.count() > 0 && (motor != Motor::Propagacao || capacidade_cache > 0))
+        {
+            std::cerr << "--fatia-us só existe com o motor propagacao e sem --cache\n";
+            return 1;
         }
-        arquivo.close();
+
+        // Solucionador e tabuleiro de cada thread, criados uma vez e reaproveitados em todos os pedidos.
+        // Como no lote, o motor paralelo divide cada pedido entre as num_threads threads: um pedido por vez.
+        unsigned threads_servico = motor == Motor::Paralelo ? 1 : num_threads;
+        CacheSolucoes cache(capacidade_cache > 0 ? static_cast<std::size_t>(capacidade_cache) : 0);
+        std::vector<Solucionador> solucionadores =
+            criar_solucionadores(capacidade_cache > 0 ? 0 : threads_servico, motor, num_threads);
+        std::vector<ResolvedorComCache<Solucionador>> com_cache;
+        if (capacidade_cache > 0)
+            com_cache = criar_com_cache(threads_servico, motor, num_threads, cache);
+        std::vector<Solucao<>> iterativos(fatia.count() > 0 ? threads_servico : 0);
+        std::vector<Tabuleiro> tabuleiros(threads_servico);
+        auto resolver = [&](unsigned id, Pedido &pedido, std::string &resultado)
+        {
+            if (!iterativos.empty())
+                return resolver_fatia(iterativos[id], pedido, fatia, resultado);
+            if (com_cache.empty())
+                resolver_linha(solucionadores[id], pedido.tabuleiro, tabuleiros[id], resultado);
+            else
+                resolver_linha(com_cache[id], pedido.tabuleiro, tabuleiros[id], resultado);
+            return true;
+        };
+        Servico<decltype(resolver)> servico(threads_servico, capacidade_fila, resolver);
+        return caminho_socket ? servir_socket(servico, caminho_socket) : servir_entrada_padrao(servico);
     }
-    else
+
+    // Cliente de teste do serviço: SudokuResolver.exe --cliente caminho_socket [arquivo] [--em-voo N]
+    if (argc > 2 && std::strcmp(argv[1], "--cliente") == 0)
     {
-        std::cout << "Não foi possível abrir o arquivo: " << nome_arquivo << "\n";
+        const char *uso = "--cliente caminho_socket [arquivo] [--em-voo N]";
+        std::ios::sync_with_stdio(false);
+        if (e_opcao(argv[2]))
+            return erro_de_uso(std::string("Falta o caminho do socket antes de ") + argv[2], uso);
+        std::string caminho = "-";
+        bool tem_caminho = false;
+        std::size_t em_voo = 0;
+        for (int i = 3; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--em-voo") == 0 && i + 1 < argc)
+                em_voo = static_cast<std::size_t>(std::max(0L, std::atol(argv[++i])));
+            // Como no lote, uma opção errada (ou sem o valor) não pode virar o nome do arquivo
+            else if (e_opcao(argv[i]))
+                return erro_de_uso(std::string("Opção desconhecida ou sem valor: ") + argv[i], uso);
+            else if (tem_caminho)
+                return erro_de_uso(std::string("Mais de um arquivo informado: ") + caminho + " e " + argv[i], uso);
+            else
+            {
+                caminho = argv[i];
+                tem_caminho = true;
+            }
+        }
+        return executar_cliente(argv[2], caminho, em_voo);
     }
-    return tabuleiro; // Retorna o tabuleiro lido (ou vazio em caso de erro)
-}
 
-int main()
-{
-    std::setlocale(LC_ALL, "pt_BR.UTF-8"); // Configura acentuação no terminal
+    // Classifica a dificuldade: SudokuResolver.exe --classificar [arquivo] [--threads N]
+    if (argc > 1 && std::strcmp(argv[1], "--classificar") == 0)
+    {
+        const char *uso = "--classificar [arquivo] [--threads N]";
+        std::ios::sync_with_stdio(false);
+        std::string caminho = "-";
+        bool tem_caminho = false;
+        unsigned num_threads = threads_disponiveis();
+        for (int i = 2; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+                num_threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+            // Como no lote, uma opção errada (ou sem o valor) não pode virar o nome do arquivo
+            else if (e_opcao(argv[i]))
+                return erro_de_uso(std::string("Opção desconhecida ou sem valor: ") + argv[i], uso);
+            else if (tem_caminho)
+                return erro_de_uso(std::string("Mais de um arquivo informado: ") + caminho + " e " + argv[i], uso);
+            else
+            {
+                caminho = argv[i];
+                tem_caminho = true;
+            }
+        }
+
+        std::array<std::size_t, NUM_TECNICAS> por_tecnica;
+        ResultadoLote resultado;
+        if (com_fonte(caminho, num_threads, [&](auto &fonte)
+                      {
+                          resultado = classificar_lote(fonte, num_threads, std::cout, por_tecnica);
+                          return 0; }) != 0)
+            return 1;
+
+        // Resumo no stderr: quantos quebra-cabeças precisaram de cada técnica
+        std::cerr << "Técnica mais difícil | Nota | Quebra-cabeças\n";
+        for (std::size_t t = 0; t < NUM_TECNICAS; ++t)
+        {
+            if (por_tecnica[t])
+                std::cerr << nome_tecnica(static_cast<Tecnica>(t)) << " | " << texto_nota(nota_tecnica(static_cast<Tecnica>(t)))
+                          << " | " << por_tecnica[t] << "\n";
+        }
+        std::cerr << "Classificados: " << resultado.resolvidos << " de " << resultado.total
+                  << " | Threads: " << num_threads << " | Tempo total: " << resultado.segundos * 1000.0 << " ms"
+                  << " | Quebra-cabeças/s: " << (resultado.segundos > 0 ? resultado.total / resultado.segundos : 0.0) << std::endl;
+        return resultado.resolvidos == resultado.total ? 0 : 1;
+    }
 
     // Pede ao usuário o nome do arquivo do Sudoku a ser resolvido
     std::string nome_arquivo;
@@ -264,7 +1065,7 @@ int main()
     std::cin >> nome_arquivo;
 
     // Lê o tabuleiro do arquivo
-    std::vector<std::vector<char>> tabuleiro = carregar_tabuleiro(nome_arquivo);
+    Tabuleiro tabuleiro = carregar_tabuleiro(nome_arquivo);
 
     std::cout << "Quebra-cabeça de Sudoku carregado:\n";
     imprimir_tabuleiro(tabuleiro);
@@ -280,8 +1081,8 @@ int main()
     // Inicia a contagem de tempo para resolver o Sudoku
     auto inicio = std::chrono::high_resolution_clock::now();
 
-    // Tenta resolver o Sudoku
-    Solucao solucao;
+    // Tenta resolver o Sudoku, mostrando cada passo no terminal
+    Solucao<RastreioTexto> solucao;
     bool resolveu = solucao.resolverSudoku(tabuleiro);
 
     // Para o cronômetro
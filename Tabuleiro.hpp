@@ -0,0 +1,297 @@
+// Tabuleiro.hpp
+
+#pragma once
+
+#include <array>    // Para as 81 células e as máscaras de tamanho fixo
+#include <cstdint>  // Para std::uint16_t (máscaras de 9 bits)
+#include <iostream> // Para imprimir o tabuleiro
+#include <fstream>  // Para ler e salvar tabuleiros em arquivos
+#include <string>   // Para nomes de arquivos e linhas de texto
+#include <string_view> // Para converter linhas sem copiá-las
+#include <cstring>  // Para std::memcpy nas conversões de 8 em 8 caracteres
+
+// Máscara de dígitos: o bit d indica o dígito d + 1
+using Mascara = std::uint16_t;
+
+// Máscara com os 9 dígitos presentes
+constexpr Mascara TODOS_DIGITOS = 0x1FF;
+
+// Função que retorna o índice da região 3x3 para uma posição no tabuleiro
+constexpr std::size_t obter_regiao(std::size_t linha, std::size_t coluna) noexcept
+{
+    return (linha / 3) * 3 + coluna / 3;
+}
+
+// Gera as 27 unidades do tabuleiro (9 linhas, 9 colunas e 9 regiões), cada uma com os índices das suas 9 células
+constexpr std::array<std::array<std::uint8_t, 9>, 27> gerar_unidades() noexcept
+{
+    std::array<std::array<std::uint8_t, 9>, 27> unidades{};
+    for (std::size_t i = 0; i < 9; ++i)
+    {
+        for (std::size_t j = 0; j < 9; ++j)
+        {
+            unidades[i][j] = static_cast<std::uint8_t>(i * 9 + j);                                  // Linha i
+            unidades[9 + i][j] = static_cast<std::uint8_t>(j * 9 + i);                              // Coluna i
+            unidades[18 + i][j] = static_cast<std::uint8_t>((i / 3 * 3 + j / 3) * 9 + i % 3 * 3 + j % 3); // Região i
+        }
+    }
+    return unidades;
+}
+
+// Tabela das unidades calculada em tempo de compilação
+constexpr std::array<std::array<std::uint8_t, 9>, 27> UNIDADES = gerar_unidades();
+
+// Tabuleiro 9x9 guardado em 81 bytes contíguos (linha a linha), sem nenhuma alocação.
+// As máscaras dos dígitos já usados em cada linha, coluna e região ficam logo ao lado das células,
+// então copiar um tabuleiro copia também o estado que o solucionador precisa.
+struct Tabuleiro
+{
+    std::array<char, 81> celulas;
+    std::array<Mascara, 9> linha_contem;
+    std::array<Mascara, 9> coluna_contem;
+    std::array<Mascara, 9> regiao_contem;
+
+    // Cria um tabuleiro vazio
+    Tabuleiro() noexcept
+    {
+        limpar();
+    }
+
+    // Acesso por linha e coluna
+    char &operator()(std::size_t linha, std::size_t coluna) noexcept
+    {
+        return celulas[linha * 9 + coluna];
+    }
+
+    char operator()(std::size_t linha, std::size_t coluna) const noexcept
+    {
+        return celulas[linha * 9 + coluna];
+    }
+
+    // Esvazia todas as células e zera as máscaras
+    void limpar() noexcept
+    {
+        celulas.fill('.');
+        linha_contem.fill(0);
+        coluna_contem.fill(0);
+        regiao_contem.fill(0);
+    }
+
+    // Recalcula as máscaras a partir das células (supõe que só há '.' ou '1'..'9')
+    void recalcular_mascaras() noexcept
+    {
+        linha_contem.fill(0);
+        coluna_contem.fill(0);
+        regiao_contem.fill(0);
+        for (std::size_t linha = 0; linha < 9; ++linha)
+        {
+            for (std::size_t coluna = 0; coluna < 9; ++coluna)
+            {
+                char digito = (*this)(linha, coluna);
+                if (digito != '.')
+                {
+                    Mascara bit = static_cast<Mascara>(1u << (digito - '1'));
+                    linha_contem[linha] |= bit;
+                    coluna_contem[coluna] |= bit;
+                    regiao_contem[obter_regiao(linha, coluna)] |= bit;
+                }
+            }
+        }
+    }
+
+    // Dígitos que já aparecem na linha, coluna ou região da célula
+    Mascara contem(std::size_t linha, std::size_t coluna) const noexcept
+    {
+        return linha_contem[linha] | coluna_contem[coluna] | regiao_contem[obter_regiao(linha, coluna)];
+    }
+
+    // Dígitos já usados na unidade (0..8 linhas, 9..17 colunas, 18..26 regiões)
+    Mascara contem_unidade(std::size_t unidade) const noexcept
+    {
+        if (unidade < 9)
+            return linha_contem[unidade];
+        if (unidade < 18)
+            return coluna_contem[unidade - 9];
+        return regiao_contem[unidade - 18];
+    }
+
+    // Dígitos que ainda podem ir na célula (índice 0..80)
+    Mascara candidatos(std::size_t celula) const noexcept
+    {
+        return static_cast<Mascara>(~contem(celula / 9, celula % 9) & TODOS_DIGITOS);
+    }
+
+    // Coloca o dígito (índice 0..8) na célula e marca nas máscaras
+    void colocar(std::size_t linha, std::size_t coluna, std::size_t idx_digito) noexcept
+    {
+        Mascara bit = static_cast<Mascara>(1u << idx_digito);
+        (*this)(linha, coluna) = static_cast<char>(idx_digito + '1');
+        linha_contem[linha] |= bit;
+        coluna_contem[coluna] |= bit;
+        regiao_contem[obter_regiao(linha, coluna)] |= bit;
+    }
+
+    // Esvazia a célula e desmarca o dígito (índice 0..8) nas máscaras
+    void remover(std::size_t linha, std::size_t coluna, std::size_t idx_digito) noexcept
+    {
+        Mascara bit = static_cast<Mascara>(~(1u << idx_digito));
+        (*this)(linha, coluna) = '.';
+        linha_contem[linha] &= bit;
+        coluna_contem[coluna] &= bit;
+        regiao_contem[obter_regiao(linha, coluna)] &= bit;
+    }
+};
+
+// Imprime o tabuleiro com divisórias de bloco, espaço antes e depois
+inline void imprimir_tabuleiro(const Tabuleiro &tabuleiro)
+{
+    std::cout << '\n'; // Linha em branco antes do tabuleiro
+    for (std::size_t linha = 0; linha < 9; ++linha)
+    {
+        // Linha divisória entre blocos horizontais
+        if (linha % 3 == 0 && linha != 0)
+        {
+            std::cout << "------+-------+------\n";
+        }
+        for (std::size_t coluna = 0; coluna < 9; ++coluna)
+        {
+            // Linha divisória entre blocos verticais
+            if (coluna % 3 == 0 && coluna != 0)
+            {
+                std::cout << "| ";
+            }
+            char c = tabuleiro(linha, coluna);
+            // Mostra "." para vazio, ou o valor para preenchido
+            if (c == '.')
+                std::cout << ". ";
+            else
+                std::cout << c << ' ';
+        }
+        std::cout << '\n'; // Fim da linha do tabuleiro
+    }
+    std::cout << '\n'; // Linha em branco após o tabuleiro
+}
+
+// Função para carregar um tabuleiro de Sudoku de um arquivo texto (9 linhas de 9 caracteres)
+inline Tabuleiro carregar_tabuleiro(const std::string &nome_arquivo)
+{
+    Tabuleiro tabuleiro; // Inicializa tudo vazio
+    std::ifstream arquivo(nome_arquivo);
+    if (arquivo.is_open())
+    {
+        // Lê caractere a caractere, preenchendo o tabuleiro
+        for (char &celula : tabuleiro.celulas)
+        {
+            arquivo >> celula;
+        }
+        arquivo.close();
+    }
+    else
+    {
+        std::cout << "Não foi possível abrir o arquivo: " << nome_arquivo << "\n";
+    }
+    return tabuleiro; // Retorna o tabuleiro lido (ou vazio em caso de erro)
+}
+
+// Função para salvar o tabuleiro de Sudoku em um arquivo texto
+inline void salvar_tabuleiro(const Tabuleiro &tabuleiro, const std::string &nome_arquivo)
+{
+    std::ofstream arquivo(nome_arquivo);
+    if (!arquivo.is_open())
+    {
+        std::cout << "Não foi possível salvar o arquivo: " << nome_arquivo << "\n";
+        return;
+    }
+    // Escreve o tabuleiro no arquivo, linha por linha
+    for (std::size_t linha = 0; linha < 9; ++linha)
+    {
+        arquivo.write(&tabuleiro.celulas[linha * 9], 9);
+        arquivo << "\n";
+    }
+    arquivo.close();
+}
+
+// Funções SWAR ("SIMD dentro de um registrador"): tratam 8 caracteres de uma vez num inteiro de 64 bits
+namespace swar
+{
+    // Byte repetido nas 8 posições
+    constexpr std::uint64_t repetir(unsigned char byte) noexcept
+    {
+        return 0x0101010101010101ull * byte;
+    }
+
+    constexpr std::uint64_t ALTOS = repetir(0x80); // Bit mais alto de cada byte
+
+    // Lê 8 bytes sem exigir alinhamento
+    inline std::uint64_t ler(const char *dados) noexcept
+    {
+        std::uint64_t palavra;
+        std::memcpy(&palavra, dados, 8);
+        return palavra;
+    }
+
+    // Bit alto ligado em cada byte igual a 'c' (exato, sem falsos positivos)
+    inline std::uint64_t bytes_iguais(std::uint64_t palavra, unsigned char c) noexcept
+    {
+        std::uint64_t x = palavra ^ repetir(c);
+        return ~(((x & ~ALTOS) + ~ALTOS) | x) & ALTOS;
+    }
+
+    // Bit alto ligado em cada byte que é '.' ou de '0' a '9'
+    inline std::uint64_t bytes_validos(std::uint64_t palavra) noexcept
+    {
+        // Com os bytes abaixo de 0x80, as somas não passam de um byte para o outro
+        std::uint64_t ascii = ~palavra & ALTOS;
+        std::uint64_t baixos = palavra & ~ALTOS;
+        std::uint64_t a_partir_de_0 = baixos + repetir(0x80 - '0');       // Bit alto se o byte >= '0'
+        std::uint64_t a_partir_de_dois_pontos = baixos + repetir(0x80 - ':'); // Bit alto se o byte > '9'
+        std::uint64_t digitos = a_partir_de_0 & ~a_partir_de_dois_pontos;
+        return ascii & (digitos | bytes_iguais(palavra, '.'));
+    }
+
+    // Troca cada '0' por '.' (o bit alto de cada '0' vira a máscara do byte)
+    inline std::uint64_t zeros_para_pontos(std::uint64_t palavra) noexcept
+    {
+        std::uint64_t zeros = bytes_iguais(palavra, '0') >> 7; // 0x01 em cada byte '0'
+        return palavra ^ (zeros * ('0' ^ '.'));
+    }
+}
+
+// Converte uma linha de 81 caracteres ('.' ou '0' para vazio) em tabuleiro; retorna false se o tamanho for inválido.
+// As máscaras não são recalculadas aqui, porque a linha ainda pode ter caracteres inválidos.
+// Confere e converte 8 caracteres por vez; só uma linha com caractere inválido cai no laço byte a byte.
+inline bool linha_para_tabuleiro(std::string_view linha, Tabuleiro &tabuleiro) noexcept
+{
+    if (linha.size() != 81)
+    {
+        return false;
+    }
+    const char *dados = linha.data();
+    std::uint64_t validos = swar::ALTOS;
+    for (std::size_t i = 0; i < 80; i += 8)
+        validos &= swar::bytes_validos(swar::ler(dados + i));
+    char ultimo = dados[80];
+    if (validos == swar::ALTOS && (ultimo == '.' || (ultimo >= '0' && ultimo <= '9')))
+    {
+        for (std::size_t i = 0; i < 80; i += 8)
+        {
+            std::uint64_t palavra = swar::zeros_para_pontos(swar::ler(dados + i));
+            std::memcpy(tabuleiro.celulas.data() + i, &palavra, 8);
+        }
+        tabuleiro.celulas[80] = (ultimo == '0') ? '.' : ultimo;
+        return true;
+    }
+    for (std::size_t i = 0; i < 81; ++i)
+    {
+        char c = dados[i];
+        tabuleiro.celulas[i] = (c == '0') ? '.' : c;
+    }
+    return true;
+}
+
+// Acrescenta o tabuleiro em uma única linha de 81 caracteres
+inline void escrever_linha(const Tabuleiro &tabuleiro, std::string &saida)
+{
+    saida.append(tabuleiro.celulas.begin(), tabuleiro.celulas.end());
+    saida += '\n';
+}